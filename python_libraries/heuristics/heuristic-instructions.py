@@ -40,6 +40,15 @@ def onLitInvolvedInConflict(lit):
     """
     pass
 
+def onLitsInvolvedInConflict(*lits):
+    """
+    Optional.
+    When a conflict is analyzed, all literals involved in the computation of the learned clause.
+    If this method is present onLitInvolvedInConflict is not invoked.
+    :param lits: the literals involved in the conflict
+    """
+    pass
+
 def onLoopFormula(lbd, size, *lits):
     """
     Optional.
@@ -109,4 +118,17 @@ def selectLiteral():
      - wasp.unroll(v) unroll the truth value of the variable v
     :return: wasp.choice(l), where l is a literal
     """
-    pass
\ No newline at end of file
+    pass
+
+def selectLiterals():
+    """
+    Optional, it replaces selectLiteral.
+    This method is invoked when a choice is needed and the previous queue of choices is over.
+    It returns a queue of choices and special values, concatenated in the order they must be used.
+    Choices that are already assigned are skipped.
+    After a backjump the queue is used again starting from the first choice, while special values
+    are used only once. The queue is discarded if the solver backjumps below the decision level
+    in which it was computed.
+    :return: e.g. wasp.choices([l1, l2]) + wasp.restart(), where l1 and l2 are literals
+    """
+    pass
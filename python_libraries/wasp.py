@@ -118,6 +118,12 @@ def factorFallback(elements):
 def choice(l):
     return [l, 0, 0]
         
+def choices(lits):
+    output = []
+    for l in lits:
+        output.extend(choice(l))
+    return output
+
 def restart():
     return [1, 0]
     
@@ -0,0 +1,300 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "CuttingPlanes.h"
+#include "Clause.h"
+#include "ReasonForBinaryClauses.h"
+#include "Solver.h"
+#include "propagators/CardinalityConstraint.h"
+#include "propagators/PseudoBooleanConstraint.h"
+
+bool
+CuttingPlanes::isPending(
+    Literal lit ) const
+{
+    return solver.isFalse( lit ) && solver.getDecisionLevel( lit ) == decisionLevel;
+}
+
+PseudoBooleanConstraint*
+CuttingPlanes::onConflict(
+    Literal conflictLiteral,
+    Reason* conflictReason )
+{
+    assert( conflictLiteral != Literal::null && conflictReason != NULL );
+    if( ++numberOfCalls == 0 )
+    {
+        for( unsigned int i = 0; i < visited.size(); i++ )
+            visited[ i ] = 0;
+        numberOfCalls = 1;
+    }
+    variables.clear();
+    degree = 0;
+    pending = 0;
+    decisionLevel = solver.getCurrentDecisionLevel();
+
+    trace_msg( learning, 2, "Cutting planes: conflict literal " << conflictLiteral << " - Conflict implicant: " << *conflictReason );
+    if( !readReason( conflictReason, conflictLiteral ) || !addReason( 1 ) )
+        return NULL;
+    saturate();
+
+    unsigned int position = solver.numberOfAssignedLiterals();
+    while( pending > 1 )
+    {
+        assert( position > 0 );
+        Var v = solver.getAssignedVariable( --position );
+        if( visited[ v ] != numberOfCalls || coefficients[ v ] == 0 || !solver.isFalse( literals[ v ] ) )
+            continue;
+
+        assert( solver.getDecisionLevel( v ) == decisionLevel );
+        Reason* reason = solver.getImplicant( v );
+        if( reason == NULL )
+            return NULL;
+
+        Literal implied = literals[ v ].getOppositeLiteral();
+        trace_msg( learning, 3, "Cutting planes: resolving " << implied << " with " << *reason );
+        if( !readReason( reason, implied ) || !weakenReason( implied ) || !addReason( coefficients[ v ] ) )
+            return NULL;
+        saturate();
+    }
+
+    assert( isViolated() );
+    return createConstraint();
+}
+
+bool
+CuttingPlanes::readReason(
+    Reason* reason,
+    Literal implied )
+{
+    reasonLiterals.clear();
+    reasonCoefficients.clear();
+    if( Clause* clause = dynamic_cast< Clause* >( reason ) )
+    {
+        for( unsigned int i = 0; i < clause->size(); i++ )
+        {
+            reasonLiterals.push_back( clause->getAt( i ) );
+            reasonCoefficients.push_back( 1 );
+        }
+        reasonDegree = 1;
+    }
+    else if( ReasonForBinaryClauses* binary = dynamic_cast< ReasonForBinaryClauses* >( reason ) )
+    {
+        Literal other( binary->getVariable(), POSITIVE );
+        reasonLiterals.push_back( implied );
+        reasonLiterals.push_back( solver.isFalse( other ) ? other : other.getOppositeLiteral() );
+        reasonCoefficients.push_back( 1 );
+        reasonCoefficients.push_back( 1 );
+        reasonDegree = 1;
+    }
+    else if( PseudoBooleanConstraint* pb = dynamic_cast< PseudoBooleanConstraint* >( reason ) )
+    {
+        for( unsigned int i = 0; i < pb->size(); i++ )
+        {
+            reasonLiterals.push_back( pb->getLiteral( i ) );
+            reasonCoefficients.push_back( pb->getWeight( i ) );
+        }
+        reasonDegree = pb->getBound();
+    }
+    else if( CardinalityConstraint* cc = dynamic_cast< CardinalityConstraint* >( reason ) )
+    {
+        for( unsigned int i = 0; i < cc->size(); i++ )
+        {
+            reasonLiterals.push_back( ( *cc )[ i ] );
+            reasonCoefficients.push_back( 1 );
+        }
+        reasonDegree = cc->getBound();
+    }
+    else
+    {
+        trace_msg( learning, 3, "Cutting planes: unsupported reason " << *reason );
+        return false;
+    }
+    return true;
+}
+
+bool
+CuttingPlanes::weakenReason(
+    Literal implied )
+{
+    //The literals that are not false when the implied literal is inferred are removed.
+    unsigned int positionOfImplied = solver.getPositionInTrail( implied.getVariable() );
+    uint64_t coefficientOfImplied = 0;
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < reasonLiterals.size(); i++ )
+    {
+        Literal lit = reasonLiterals[ i ];
+        if( lit == implied )
+            coefficientOfImplied = reasonCoefficients[ i ];
+        else if( !solver.isFalse( lit ) || solver.getPositionInTrail( lit.getVariable() ) > positionOfImplied )
+        {
+            if( reasonDegree <= reasonCoefficients[ i ] )
+                return false;
+            reasonDegree -= reasonCoefficients[ i ];
+            continue;
+        }
+        reasonLiterals[ j ] = lit;
+        reasonCoefficients[ j++ ] = reasonCoefficients[ i ];
+    }
+    reasonLiterals.shrink( j );
+    reasonCoefficients.shrink( j );
+    assert( coefficientOfImplied > 0 );
+    if( coefficientOfImplied <= 1 )
+        return true;
+
+    //The implied literal gets coefficient 1.
+    for( unsigned int i = 0; i < reasonCoefficients.size(); i++ )
+        reasonCoefficients[ i ] = ( reasonCoefficients[ i ] + coefficientOfImplied - 1 ) / coefficientOfImplied;
+    reasonDegree = ( reasonDegree + coefficientOfImplied - 1 ) / coefficientOfImplied;
+    return true;
+}
+
+bool
+CuttingPlanes::addReason(
+    uint64_t multiplier )
+{
+    assert( multiplier > 0 );
+    if( reasonDegree > CUTTING_PLANES_MAX_COEFFICIENT / multiplier || degree + reasonDegree * multiplier > CUTTING_PLANES_MAX_COEFFICIENT )
+        return false;
+
+    degree += reasonDegree * multiplier;
+    for( unsigned int i = 0; i < reasonLiterals.size(); i++ )
+    {
+        //Saturated coefficients are not greater than the degree.
+        uint64_t coefficient = reasonCoefficients[ i ] < reasonDegree ? reasonCoefficients[ i ] : reasonDegree;
+        addLiteral( reasonLiterals[ i ], coefficient * multiplier );
+    }
+    return degree > 0;
+}
+
+void
+CuttingPlanes::addLiteral(
+    Literal lit,
+    uint64_t coefficient )
+{
+    Var v = lit.getVariable();
+    if( visited[ v ] != numberOfCalls )
+    {
+        visited[ v ] = numberOfCalls;
+        variables.push_back( v );
+        coefficients[ v ] = 0;
+    }
+
+    if( coefficients[ v ] == 0 )
+    {
+        literals[ v ] = lit;
+        coefficients[ v ] = coefficient;
+        if( isPending( lit ) )
+            pending++;
+        return;
+    }
+
+    if( literals[ v ] == lit )
+    {
+        coefficients[ v ] += coefficient;
+        return;
+    }
+
+    //x + not x = 1
+    bool wasPending = isPending( literals[ v ] );
+    if( coefficients[ v ] > coefficient )
+    {
+        coefficients[ v ] -= coefficient;
+        degree -= coefficient;
+    }
+    else
+    {
+        degree -= coefficients[ v ];
+        coefficients[ v ] = coefficient - coefficients[ v ];
+        literals[ v ] = lit;
+    }
+    bool isPendingNow = coefficients[ v ] > 0 && isPending( literals[ v ] );
+    if( wasPending && !isPendingNow )
+        pending--;
+    else if( !wasPending && isPendingNow )
+        pending++;
+}
+
+void
+CuttingPlanes::saturate()
+{
+    assert( degree > 0 );
+    for( unsigned int i = 0; i < variables.size(); i++ )
+    {
+        Var v = variables[ i ];
+        if( coefficients[ v ] > ( uint64_t ) degree )
+            coefficients[ v ] = degree;
+    }
+}
+
+PseudoBooleanConstraint*
+CuttingPlanes::createConstraint()
+{
+    int64_t bound = degree;
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < variables.size(); i++ )
+    {
+        Var v = variables[ i ];
+        if( coefficients[ v ] == 0 )
+            continue;
+        if( !solver.isUndefined( v ) && solver.getDecisionLevel( v ) == 0 )
+        {
+            if( solver.isTrue( literals[ v ] ) )
+                bound -= coefficients[ v ];
+            continue;
+        }
+        variables[ j++ ] = v;
+    }
+    variables.shrink( j );
+
+    if( bound <= 0 || variables.size() < 2 )
+        return NULL;
+
+    bool isClause = true;
+    for( unsigned int i = 0; i < variables.size() && isClause; i++ )
+        if( coefficients[ variables[ i ] ] < ( uint64_t ) bound )
+            isClause = false;
+    if( isClause )
+        return NULL;
+
+    PseudoBooleanConstraint* pb = new PseudoBooleanConstraint();
+    for( unsigned int i = 0; i < variables.size(); i++ )
+        pb->addLiteral( literals[ variables[ i ] ], coefficients[ variables[ i ] ] );
+    if( !pb->setBound( bound ) )
+    {
+        delete pb;
+        return NULL;
+    }
+    pb->sort();
+    trace_msg( learning, 1, "Cutting planes: learned constraint " << *pb );
+    return pb;
+}
+
+#ifndef NDEBUG
+bool
+CuttingPlanes::isViolated() const
+{
+    int64_t slack = -degree;
+    for( unsigned int i = 0; i < variables.size(); i++ )
+    {
+        Var v = variables[ i ];
+        if( !solver.isFalse( literals[ v ] ) )
+            slack += coefficients[ v ];
+    }
+    return slack < 0;
+}
+#endif
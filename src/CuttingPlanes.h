@@ -0,0 +1,98 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef WASP_CUTTINGPLANES_H
+#define WASP_CUTTINGPLANES_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "stl/Vector.h"
+#include "Literal.h"
+using namespace std;
+
+class PseudoBooleanConstraint;
+class Reason;
+class Solver;
+
+/**
+ * Conflict analysis with cutting planes.
+ * The constraint violated by the current assignment is added to the reasons
+ * of its literals of the current decision level (generalized resolution)
+ * until at most one of them is left, as in the first UIP learning.
+ * Before the addition a reason is weakened on the literals that are not false
+ * when the resolved literal is inferred and divided by the coefficient of the
+ * resolved literal. Coefficients greater than the degree are saturated.
+ * Clauses, cardinality and pseudo-Boolean constraints are supported: for the
+ * other reasons the analysis is stopped and only the clausal learning is used.
+ */
+class CuttingPlanes
+{
+    public:
+        inline CuttingPlanes( Solver& s ) : solver( s ), degree( 0 ), reasonDegree( 0 ), numberOfCalls( 0 ), pending( 0 ), decisionLevel( 0 ) { onNewVariable(); }
+
+        inline void onNewVariable() { coefficients.push_back( 0 ); literals.push_back( Literal::null ); visited.push_back( 0 ); }
+
+        /**
+         * Must be called before the clausal learning, which unrolls the trail.
+         * @return the learned constraint, or NULL if the analysis has been
+         * stopped or the learned constraint is a clause
+         */
+        PseudoBooleanConstraint* onConflict( Literal conflictLiteral, Reason* conflictReason );
+
+    private:
+        Solver& solver;
+
+        /**
+         * The learned constraint: for each variable, its literal and coefficient.
+         */
+        vector< uint64_t > coefficients;
+        vector< Literal > literals;
+        Vector< Var > variables;
+        int64_t degree;
+
+        /**
+         * The reason currently resolved.
+         */
+        Vector< Literal > reasonLiterals;
+        Vector< uint64_t > reasonCoefficients;
+        uint64_t reasonDegree;
+
+        vector< unsigned int > visited;
+        unsigned int numberOfCalls;
+
+        /**
+         * The number of false literals of the current decision level.
+         */
+        unsigned int pending;
+        unsigned int decisionLevel;
+
+        bool readReason( Reason* reason, Literal implied );
+        bool weakenReason( Literal implied );
+        bool addReason( uint64_t multiplier );
+        void addLiteral( Literal lit, uint64_t coefficient );
+        void saturate();
+        PseudoBooleanConstraint* createConstraint();
+        inline bool isPending( Literal lit ) const;
+
+        #ifndef NDEBUG
+        bool isViolated() const;
+        #endif
+};
+
+#endif
@@ -18,26 +18,13 @@
 
 #include "DependencyGraph.h"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/strong_components.hpp>
-
-class AdjacencyList: public boost::adjacency_list<>
-{
-};
-
 DependencyGraph::DependencyGraph( Solver& s )
-: graph( *new AdjacencyList() ), solver( s ), tight_( true )
+: numberOfVertices( 0 ), solver( s ), tight_( true )
 {
 }
 
 DependencyGraph::~DependencyGraph()
 {
-    graph.clear();
-    assert( graph.vertex_set().empty() );
-    delete &graph;
-
-//    for( unsigned int i = 0; i < cyclicComponents.size(); i++ )
-//        delete cyclicComponents[ i ];
 }
 
 void
@@ -46,16 +33,118 @@ DependencyGraph::addEdge(
     unsigned int v2 )
 {
     assert( v1 != v2 );
-    boost::add_edge( v1, v2, graph );
+    edges.push_back( pair< Var, Var >( v1, v2 ) );
+    if( v1 >= numberOfVertices )
+        numberOfVertices = v1 + 1;
+    if( v2 >= numberOfVertices )
+        numberOfVertices = v2 + 1;
+}
+
+void
+DependencyGraph::buildAdjacencyLists()
+{
+    //First pass: count the successors of each vertex.
+    offsets.assign( numberOfVertices + 1, 0 );
+    for( unsigned int i = 0; i < edges.size(); i++ )
+        offsets[ edges[ i ].first + 1 ]++;
+    for( unsigned int v = 0; v < numberOfVertices; v++ )
+        offsets[ v + 1 ] += offsets[ v ];
+
+    //Second pass: store the successors keeping the order of insertion.
+    vector< unsigned int > next( offsets.begin(), offsets.end() - 1 );
+    targets.resize( edges.size() );
+    for( unsigned int i = 0; i < edges.size(); i++ )
+        targets[ next[ edges[ i ].first ]++ ] = edges[ i ].second;
+
+    vector< pair< Var, Var > >().swap( edges );
+}
+
+unsigned int
+DependencyGraph::computeComponentIds(
+    vector< unsigned int >& rindex )
+{
+    assert( numberOfVertices > 0 );
+    //rindex is 0 for unvisited vertices, the visit index for vertices on the stack and c for vertices in a component.
+    rindex.assign( numberOfVertices, 0 );
+    vector< bool > root( numberOfVertices, false );
+    vector< Var > visiting;
+    vector< unsigned int > nextEdge;
+    vector< Var > stack;
+    unsigned int index = 1;
+    unsigned int c = numberOfVertices - 1;
+
+    for( Var start = 0; start < numberOfVertices; start++ )
+    {
+        if( rindex[ start ] != 0 )
+            continue;
+
+        visiting.push_back( start );
+        nextEdge.push_back( offsets[ start ] );
+        rindex[ start ] = index++;
+        root[ start ] = true;
+
+        while( !visiting.empty() )
+        {
+            Var v = visiting.back();
+            if( nextEdge.back() < offsets[ v + 1 ] )
+            {
+                Var w = targets[ nextEdge.back()++ ];
+                if( rindex[ w ] == 0 )
+                {
+                    visiting.push_back( w );
+                    nextEdge.push_back( offsets[ w ] );
+                    rindex[ w ] = index++;
+                    root[ w ] = true;
+                }
+                else if( rindex[ w ] < rindex[ v ] )
+                {
+                    rindex[ v ] = rindex[ w ];
+                    root[ v ] = false;
+                }
+                continue;
+            }
+
+            visiting.pop_back();
+            nextEdge.pop_back();
+            if( root[ v ] )
+            {
+                index--;
+                while( !stack.empty() && rindex[ v ] <= rindex[ stack.back() ] )
+                {
+                    rindex[ stack.back() ] = c;
+                    stack.pop_back();
+                    index--;
+                }
+                rindex[ v ] = c--;
+            }
+            else
+                stack.push_back( v );
+
+            if( !visiting.empty() && rindex[ v ] < rindex[ visiting.back() ] )
+            {
+                rindex[ visiting.back() ] = rindex[ v ];
+                root[ visiting.back() ] = false;
+            }
+        }
+    }
+
+    //Components are numbered in the order they are completed.
+    for( Var v = 0; v < numberOfVertices; v++ )
+        rindex[ v ] = numberOfVertices - 1 - rindex[ v ];
+    return numberOfVertices - 1 - c;
 }
 
 void
 DependencyGraph::computeStrongConnectedComponents()
 {
-    vector< unsigned int > strongConnectedComponents( boost::num_vertices( graph ) ), discover_time( boost::num_vertices( graph ) );
-    vector< boost::default_color_type > color( boost::num_vertices( graph ) );
-    vector< boost::graph_traits< boost::adjacency_list< > >::vertex_descriptor > root( boost::num_vertices( graph ) );
-    unsigned int numberOfStrongConnectedComponents = boost::strong_components( graph, &strongConnectedComponents[ 0 ] , boost::root_map( &root[ 0 ] ).color_map( &color[ 0 ] ).discover_time_map( &discover_time[ 0 ] ) );
+    if( edges.empty() )
+        return;
+
+    buildAdjacencyLists();
+    vector< unsigned int > strongConnectedComponents;
+    unsigned int numberOfStrongConnectedComponents = computeComponentIds( strongConnectedComponents );
+    vector< unsigned int >().swap( offsets );
+    vector< Var >().swap( targets );
 
     assert( numberOfStrongConnectedComponents > 0 );
     vector< vector< Var > > components( numberOfStrongConnectedComponents );
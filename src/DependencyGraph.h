@@ -21,12 +21,19 @@
 
 #include <vector>
 #include <cassert>
+#include <utility>
 #include "util/WaspConstants.h"
 using namespace std;
 
-class AdjacencyList;
 class Solver;
 
+/**
+ * Positive dependency graph of the program.
+ * Edges are collected as they are added and stored in compressed sparse row
+ * form before computing the strongly connected components, which is done by
+ * an iterative version of the algorithm of Pearce (a space-efficient variant
+ * of Tarjan's algorithm) to avoid deep recursion on long chains of atoms.
+ */
 class DependencyGraph 
 {
     public:
@@ -44,8 +51,14 @@ class DependencyGraph
     private:        
         DependencyGraph( const DependencyGraph& orig );
 
+        void buildAdjacencyLists();
+        unsigned int computeComponentIds( vector< unsigned int >& rindex );
+
         vector< vector< Var > > components_;
-        AdjacencyList& graph;
+        vector< pair< Var, Var > > edges;
+        vector< unsigned int > offsets;
+        vector< Var > targets;
+        unsigned int numberOfVertices;
         Solver& solver;
         bool tight_;        
 };
@@ -26,4 +26,14 @@ GUSData::~GUSData()
 //        delete definingRulesForNonHCFAtom.back();
 //        definingRulesForNonHCFAtom.pop_back();
 //    }
-}
\ No newline at end of file
+}
+void
+GUSLists::freeze(
+    unsigned int numberOfVariables )
+{
+    externalLiterals.freeze( numberOfVariables + 1 );
+    internalLiterals.freeze( numberOfVariables + 1 );
+    literals.freeze( numberOfVariables + 1 );
+    auxVariablesSupportedByThis.freeze( ( numberOfVariables + 1 ) << 1 );
+    possiblySupportedByThis.freeze( ( numberOfVariables + 1 ) << 1 );
+}
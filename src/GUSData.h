@@ -21,6 +21,7 @@
 
 #include "Literal.h"
 #include <vector>
+#include "stl/FrozenLists.h"
 #include "stl/Vector.h"
 using namespace std;
 
@@ -32,12 +33,8 @@ class GUSData
         inline GUSData();
         ~GUSData();
 
-        vector< Literal > externalLiterals;
-        vector< Literal > internalLiterals;
         Vector< Var > supportedByThisExternalRule[ 2 ];
         Vector< Var > supportedByThisInternalRule[ 2 ];
-        vector< Var > auxVariablesSupportedByThis[ 2 ];
-        vector< Var > possiblySupportedByThis[ 2 ];
 
         vector< Clause* > definingRulesForNonHCFAtom;
         vector< Literal > definingLiteralsForNonHCFAtom;
@@ -45,7 +42,6 @@ class GUSData
         Var headVarForHCC; //For an atom p in a HCC it represents hp
 
         /* CONJUNCTIVE */
-        vector< Literal > literals;
         unsigned int numberOfSupporting;
 
         /* DISJUNCTIVE */
@@ -82,6 +78,28 @@ class GUSData
 //        unsigned int variable : 27;
 };
 
+/**
+ * The lists of GUSData that do not change after the creation of the
+ * unfounded-set structures. They are shared by all components and frozen
+ * in a single array each, so that the propagation does not follow one
+ * pointer per atom.
+ */
+class GUSLists
+{
+    public:
+        /* Indexed by variable */
+        FrozenLists< Literal > externalLiterals;
+        FrozenLists< Literal > internalLiterals;
+        FrozenLists< Literal > literals; //Body of aux variables
+
+        /* Indexed by literal */
+        FrozenLists< Var > auxVariablesSupportedByThis;
+        FrozenLists< Var > possiblySupportedByThis;
+
+        void freeze( unsigned int numberOfVariables );
+        inline bool isFrozen() const { return externalLiterals.isFrozen(); }
+};
+
 GUSData::GUSData() : numberOfSupporting( 0 ), sourcePointer( Literal::null ), aux( 0 ), founded( 1 ), inQueue( 0 ), inUnfoundedSet( 0 ), propagated( 0 )
 {
     unfoundedVarForHCC = 0;
@@ -29,6 +29,7 @@ class ReasonForBinaryClauses : public Reason
 {
     public:        
         inline ReasonForBinaryClauses( Var v ) : varId( v ) {}
+        inline Var getVariable() const { return varId; }
         virtual ~ReasonForBinaryClauses();
         virtual void onLearning( const Solver& solver, Learning* strategy, Literal lit );
         virtual bool onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit );        
@@ -0,0 +1,861 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "Snapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Solver.h"
+#include "util/VariableNames.h"
+#include "util/WaspErrorMessage.h"
+
+void
+Snapshot::write(
+    const string& filename,
+    unsigned int flags )
+{
+    if( !solver.hcComponents.empty() )
+        WaspErrorMessage::errorGeneric( "Snapshots of programs with non head-cycle-free components are not supported." );
+
+    words.clear();
+    add( SNAPSHOT_MAGIC );
+    add( SNAPSHOT_VERSION );
+    add( SNAPSHOT_BYTE_ORDER );
+    add( flags );
+    add( solver.numberOfVariables() );
+
+    if( !( flags & SNAPSHOT_FLAG_INCOHERENT ) )
+    {
+        writeNames();
+        writeFrozen();
+        writeEliminated();
+        writeClauses();
+        writeBinaryClauses();
+        writePropagators();
+        writeComponents();
+        writeOptimization();
+        writeHeuristic();
+        writeUnits();
+    }
+
+    ofstream out( filename.c_str(), ios::out | ios::binary | ios::trunc );
+    if( out.good() )
+        out.write( reinterpret_cast< const char* >( &words[ 0 ] ), words.size() * sizeof( uint32_t ) );
+    if( !out.good() )
+        WaspErrorMessage::errorGeneric( "Cannot write the snapshot to " + filename + "." );
+    trace_msg( parser, 1, "Snapshot of " << words.size() << " words written to " << filename );
+}
+
+void
+Snapshot::add(
+    const Clause& clause )
+{
+    //Deleted clauses keep their first literal in the last position.
+    if( clause.hasBeenDeleted() )
+    {
+        add( clause.size() - 1 );
+        add( clause[ clause.size() - 1 ] );
+        for( unsigned int i = 1; i < clause.size() - 1; i++ )
+            add( clause[ i ] );
+        return;
+    }
+
+    add( clause.size() );
+    for( unsigned int i = 0; i < clause.size(); i++ )
+        add( clause[ i ] );
+}
+
+void
+Snapshot::addString(
+    const char* s )
+{
+    size_t length = strlen( s ) + 1;
+    size_t position = words.size();
+    words.resize( position + ( length + sizeof( uint32_t ) - 1 ) / sizeof( uint32_t ), 0 );
+    memcpy( &words[ position ], s, length );
+}
+
+void
+Snapshot::writeNames()
+{
+    startSection( SNAPSHOT_NAMES );
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+    {
+        if( VariableNames::isHidden( v ) )
+            continue;
+        add( v );
+        add( VariableNames::hasToBePrinted( v ) ? 1 : 0 );
+        addString( VariableNames::getName( v ) );
+    }
+    endSection();
+}
+
+void
+Snapshot::writeFrozen()
+{
+    startSection( SNAPSHOT_FROZEN );
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+        if( solver.isFrozen( v ) )
+            add( v );
+    endSection();
+}
+
+void
+Snapshot::writeEliminated()
+{
+    startSection( SNAPSHOT_ELIMINATED );
+    for( unsigned int i = 0; i < solver.eliminatedVariables.size(); i++ )
+    {
+        Var v = solver.eliminatedVariables[ i ];
+        unsigned int sign = solver.getSignOfEliminatedVariable( v );
+        add( v );
+        add( sign );
+        if( sign == ELIMINATED_BY_DISTRIBUTION )
+        {
+            //The deleted clauses are needed to complete the model.
+            for( unsigned int s = POSITIVE; s <= NEGATIVE; s++ )
+            {
+                Literal lit( v, s );
+                add( solver.numberOfOccurrences( lit ) );
+                for( unsigned int j = 0; j < solver.numberOfOccurrences( lit ); j++ )
+                    add( *solver.getOccurrence( lit, j ) );
+            }
+        }
+        else
+        {
+            assert( solver.getDefinition( v ) != NULL );
+            add( *solver.getDefinition( v ) );
+        }
+    }
+    endSection();
+}
+
+void
+Snapshot::writeClauses()
+{
+    startSection( SNAPSHOT_CLAUSES );
+    for( unsigned int i = 0; i < solver.clauses.size(); i++ )
+    {
+        assert( !solver.clauses[ i ]->hasBeenDeleted() );
+        add( *solver.clauses[ i ] );
+    }
+    endSection();
+}
+
+void
+Snapshot::writeBinaryClauses()
+{
+    startSection( SNAPSHOT_BINARY_CLAUSES );
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+    {
+        for( unsigned int s = POSITIVE; s <= NEGATIVE; s++ )
+        {
+            Literal lit( v, s );
+            const Vector< Literal >& binary = solver.getDataStructure( lit ).variableBinaryClauses;
+            for( unsigned int j = 0; j < binary.size(); j++ )
+            {
+                //Each binary clause is stored in the lists of both literals.
+                if( lit.getIndex() > binary[ j ].getIndex() )
+                    continue;
+                add( lit );
+                add( binary[ j ] );
+            }
+        }
+    }
+    endSection();
+}
+
+void
+Snapshot::writePropagators()
+{
+    vector< Aggregate* > aggregates;
+    vector< CardinalityConstraint* > cardinalityConstraints;
+    vector< MultiAggregate* > multiAggregates;
+    vector< PseudoBooleanConstraint* > pseudoBooleanConstraints;
+    for( unsigned int i = 0; i < solver.propagators.size(); i++ )
+    {
+        Propagator* p = solver.propagators[ i ];
+        if( Aggregate* a = dynamic_cast< Aggregate* >( p ) )
+            aggregates.push_back( a );
+        else if( CardinalityConstraint* c = dynamic_cast< CardinalityConstraint* >( p ) )
+            cardinalityConstraints.push_back( c );
+        else if( MultiAggregate* m = dynamic_cast< MultiAggregate* >( p ) )
+            multiAggregates.push_back( m );
+        else if( PseudoBooleanConstraint* pb = dynamic_cast< PseudoBooleanConstraint* >( p ) )
+            pseudoBooleanConstraints.push_back( pb );
+        else
+            WaspErrorMessage::errorGeneric( "Snapshots of this kind of propagator are not supported." );
+    }
+
+    startSection( SNAPSHOT_AGGREGATES );
+    for( unsigned int i = 0; i < aggregates.size(); i++ )
+    {
+        const Aggregate& aggregate = *aggregates[ i ];
+        add64( aggregate.getBound() );
+        add( aggregate.size() );
+        for( unsigned int j = 1; j <= aggregate.size(); j++ )
+        {
+            add( aggregate.getLiteral( j ) );
+            add64( aggregate.getWeight( j ) );
+        }
+    }
+    endSection();
+
+    startSection( SNAPSHOT_CARDINALITY_CONSTRAINTS );
+    for( unsigned int i = 0; i < cardinalityConstraints.size(); i++ )
+    {
+        const CardinalityConstraint& cc = *cardinalityConstraints[ i ];
+        add64( cc.getBound() );
+        add( cc.size() );
+        for( unsigned int j = 0; j < cc.size(); j++ )
+            add( cc[ j ] );
+    }
+    endSection();
+
+    startSection( SNAPSHOT_MULTI_AGGREGATES );
+    for( unsigned int i = 0; i < multiAggregates.size(); i++ )
+    {
+        const MultiAggregate& multi = *multiAggregates[ i ];
+        add( multi.size() );
+        for( unsigned int j = 1; j <= multi.size(); j++ )
+        {
+            add( multi.getLiteral( j ) );
+            add64( multi.getWeight( j ) );
+        }
+        add( multi.numberOfBounds() );
+        for( unsigned int j = 1; j <= multi.numberOfBounds(); j++ )
+        {
+            add( multi.getId( j ) );
+            add64( multi.getBound( j ) );
+        }
+    }
+    endSection();
+
+    startSection( SNAPSHOT_PSEUDO_BOOLEAN_CONSTRAINTS );
+    for( unsigned int i = 0; i < pseudoBooleanConstraints.size(); i++ )
+    {
+        const PseudoBooleanConstraint& pb = *pseudoBooleanConstraints[ i ];
+        add64( pb.getBound() );
+        add( pb.size() );
+        for( unsigned int j = 0; j < pb.size(); j++ )
+        {
+            add( pb.getLiteral( j ) );
+            add64( pb.getWeight( j ) );
+        }
+    }
+    endSection();
+
+    startSection( SNAPSHOT_DISJUNCTIONS );
+    for( unsigned int i = 0; i < solver.disjunctionPropagators.size(); i++ )
+    {
+        const DisjunctionPropagator& disjunction = *solver.disjunctionPropagators[ i ];
+        add( disjunction.getBodyLiteral() );
+        add( disjunction.size() );
+        for( unsigned int j = 1; j <= disjunction.size(); j++ )
+        {
+            add( disjunction.getOriginalLiteral( j ) );
+            add( disjunction.getAuxLiteral( j ) );
+        }
+    }
+    endSection();
+}
+
+void
+Snapshot::writeComponents()
+{
+    startSection( SNAPSHOT_GUS_DATA );
+    add( solver.gusDataVector.size() );
+    for( unsigned int i = 0; i < solver.gusDataVector.size(); i++ )
+    {
+        const GUSData* gd = solver.gusDataVector[ i ];
+        if( gd == NULL )
+        {
+            add( 0 );
+            continue;
+        }
+        add( gd->isAux() ? 3 : 1 );
+        const GUSLists& lists = solver.gusLists;
+        const FrozenLists< Literal >* literals[ 3 ] = { &lists.externalLiterals, &lists.internalLiterals, &lists.literals };
+        for( unsigned int k = 0; k < 3; k++ )
+        {
+            add( literals[ k ]->size( i ) );
+            for( unsigned int j = 0; j < literals[ k ]->size( i ); j++ )
+                add( literals[ k ]->get( i, j ) );
+        }
+        const FrozenLists< Var >* vars[ 2 ] = { &lists.possiblySupportedByThis, &lists.auxVariablesSupportedByThis };
+        for( unsigned int k = 0; k < 4; k++ )
+        {
+            unsigned int index = Literal( i, k & 1 ).getIndex();
+            add( vars[ k >> 1 ]->size( index ) );
+            for( unsigned int j = 0; j < vars[ k >> 1 ]->size( index ); j++ )
+                add( vars[ k >> 1 ]->get( index, j ) );
+        }
+    }
+    endSection();
+
+    startSection( SNAPSHOT_COMPONENTS );
+    unordered_map< PostPropagator*, unsigned int > ids;
+    add( solver.cyclicComponents.size() );
+    for( unsigned int i = 0; i < solver.cyclicComponents.size(); i++ )
+    {
+        const Component& component = *solver.cyclicComponents[ i ];
+        ids[ solver.cyclicComponents[ i ] ] = i;
+        add( component.size() );
+        for( unsigned int j = 0; j < component.size(); j++ )
+            add( component.getVariable( j ) );
+    }
+
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+    {
+        for( unsigned int s = POSITIVE; s <= NEGATIVE; s++ )
+        {
+            Literal lit( v, s );
+            const Vector< PostPropagator* >& postPropagators = solver.getDataStructure( lit ).variablePostPropagators;
+            for( unsigned int j = 0; j < postPropagators.size(); j++ )
+            {
+                unordered_map< PostPropagator*, unsigned int >::iterator it = ids.find( postPropagators[ j ] );
+                if( it == ids.end() )
+                    WaspErrorMessage::errorGeneric( "Snapshots of this kind of post propagator are not supported." );
+                add( lit );
+                add( it->second );
+            }
+        }
+    }
+    endSection();
+}
+
+void
+Snapshot::writeOptimization()
+{
+    startSection( SNAPSHOT_OPTIMIZATION );
+    add( solver.numberOfLevels() );
+    for( unsigned int level = 0; level < solver.numberOfLevels(); level++ )
+    {
+        add( solver.numberOfOptimizationLiterals( level ) );
+        for( unsigned int i = 0; i < solver.numberOfOptimizationLiterals( level ); i++ )
+        {
+            OptimizationLiteralData& opt = solver.getOptimizationLiteral( level, i );
+            add( opt.lit );
+            add64( opt.weight );
+            add( opt.isAux() ? 1 : 0 );
+        }
+    }
+    endSection();
+}
+
+void
+Snapshot::writeHeuristic()
+{
+    startSection( SNAPSHOT_HEURISTIC );
+    for( unsigned int i = 0; i < solver.choiceHeuristic->numberOfDomainHeuristics(); i++ )
+    {
+        Var v;
+        unsigned int modifier;
+        int bias;
+        unsigned int priority;
+        solver.choiceHeuristic->getDomainHeuristic( i, v, modifier, bias, priority );
+        add( v );
+        add( modifier );
+        add( static_cast< uint32_t >( bias ) );
+        add( priority );
+    }
+    endSection();
+}
+
+void
+Snapshot::writeUnits()
+{
+    startSection( SNAPSHOT_UNITS );
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+        if( !solver.hasBeenEliminated( v ) && !solver.isUndefined( v ) )
+            add( solver.createFromAssignedVariable( v ) );
+    endSection();
+}
+
+unsigned int
+Snapshot::read(
+    const string& filename )
+{
+    int fd = open( filename.c_str(), O_RDONLY );
+    if( fd < 0 )
+        WaspErrorMessage::errorGeneric( "Cannot open the snapshot " + filename + "." );
+
+    //Regular files are mapped in memory, pipes are read in a buffer.
+    struct stat info;
+    void* mapped = MAP_FAILED;
+    if( fstat( fd, &info ) == 0 && S_ISREG( info.st_mode ) && info.st_size > 0 )
+        mapped = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    vector< char > buffer;
+    size_t bytes;
+    if( mapped != MAP_FAILED )
+    {
+        data = static_cast< const uint32_t* >( mapped );
+        bytes = info.st_size;
+    }
+    else
+    {
+        char chunk[ 65536 ];
+        ssize_t n;
+        while( ( n = ::read( fd, chunk, sizeof( chunk ) ) ) > 0 )
+            buffer.insert( buffer.end(), chunk, chunk + n );
+        if( n < 0 )
+            WaspErrorMessage::errorGeneric( "Cannot read the snapshot " + filename + "." );
+        //vector< char > is not guaranteed to be aligned for words.
+        words.resize( ( buffer.size() + sizeof( uint32_t ) - 1 ) / sizeof( uint32_t ) );
+        if( !buffer.empty() )
+            memcpy( &words[ 0 ], &buffer[ 0 ], buffer.size() );
+        data = words.empty() ? NULL : &words[ 0 ];
+        bytes = buffer.size();
+    }
+    close( fd );
+
+    if( bytes % sizeof( uint32_t ) != 0 )
+        WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+    size = bytes / sizeof( uint32_t );
+    pos = 0;
+
+    unsigned int flags = load();
+
+    if( mapped != MAP_FAILED )
+        munmap( mapped, info.st_size );
+    data = NULL;
+    words.clear();
+    return flags;
+}
+
+unsigned int
+Snapshot::load()
+{
+    if( size < SNAPSHOT_HEADER_SIZE || next() != SNAPSHOT_MAGIC )
+        WaspErrorMessage::errorGeneric( "The file is not a snapshot." );
+    if( next() != SNAPSHOT_VERSION )
+        WaspErrorMessage::errorGeneric( "The snapshot has been written by a different version of the solver." );
+    if( next() != SNAPSHOT_BYTE_ORDER )
+        WaspErrorMessage::errorGeneric( "The snapshot has been written on a machine with a different byte order." );
+    unsigned int flags = next();
+    unsigned int numberOfVariables = next();
+
+    if( solver.numberOfVariables() != 0 )
+        WaspErrorMessage::errorGeneric( "Snapshots must be loaded in an empty solver." );
+    for( unsigned int i = 0; i < numberOfVariables; i++ )
+        solver.addVariable();
+
+    //The program has been already simplified.
+    solver.turnOffSimplifications();
+    if( flags & SNAPSHOT_FLAG_INCOHERENT )
+    {
+        solver.addClause( solver.newClause() );
+        return flags;
+    }
+
+    while( pos < size )
+    {
+        uint32_t tag = next();
+        size_t end = next();
+        end += pos;
+        if( end > size )
+            WaspErrorMessage::errorGeneric( "Truncated snapshot." );
+        trace_msg( parser, 2, "Reading section " << tag << " of the snapshot" );
+        switch( tag )
+        {
+            case SNAPSHOT_NAMES: readNames(); break;
+            case SNAPSHOT_FROZEN: readFrozen(); break;
+            case SNAPSHOT_ELIMINATED: readEliminated(); break;
+            case SNAPSHOT_CLAUSES: readClauses(); break;
+            case SNAPSHOT_BINARY_CLAUSES: readBinaryClauses(); break;
+            case SNAPSHOT_AGGREGATES: readAggregates(); break;
+            case SNAPSHOT_CARDINALITY_CONSTRAINTS: readCardinalityConstraints(); break;
+            case SNAPSHOT_MULTI_AGGREGATES: readMultiAggregates(); break;
+            case SNAPSHOT_PSEUDO_BOOLEAN_CONSTRAINTS: readPseudoBooleanConstraints(); break;
+            case SNAPSHOT_DISJUNCTIONS: readDisjunctions(); break;
+            case SNAPSHOT_GUS_DATA: readGUSData(); break;
+            case SNAPSHOT_COMPONENTS: readComponents(); break;
+            case SNAPSHOT_OPTIMIZATION: readOptimization(); break;
+            case SNAPSHOT_HEURISTIC: readHeuristic(); break;
+            case SNAPSHOT_UNITS:
+                if( !readUnits() )
+                    return flags;
+                break;
+            default: pos = end; break;
+        }
+        if( pos != end )
+            WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+    }
+
+    solver.endPreprocessing();
+    return flags;
+}
+
+uint32_t
+Snapshot::next()
+{
+    if( pos >= size )
+        WaspErrorMessage::errorGeneric( "Truncated snapshot." );
+    return data[ pos++ ];
+}
+
+Var
+Snapshot::nextVariable()
+{
+    Var v = next();
+    if( v == 0 || v > solver.numberOfVariables() )
+        WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+    return v;
+}
+
+Literal
+Snapshot::nextLiteral()
+{
+    uint32_t index = next();
+    Literal lit( index >> 1, index & 1 );
+    if( lit.getVariable() > solver.numberOfVariables() )
+        WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+    return lit;
+}
+
+Clause*
+Snapshot::nextClause()
+{
+    unsigned int length = next();
+    Clause* clause = solver.newClause( length );
+    for( unsigned int i = 0; i < length; i++ )
+        clause->addLiteral( nextLiteral() );
+    return clause;
+}
+
+const char*
+Snapshot::nextString()
+{
+    const char* s = reinterpret_cast< const char* >( data + pos );
+    size_t maxLength = ( size - pos ) * sizeof( uint32_t );
+    size_t length = strnlen( s, maxLength );
+    if( length == maxLength )
+        WaspErrorMessage::errorGeneric( "Truncated snapshot." );
+    pos += ( length + sizeof( uint32_t ) ) / sizeof( uint32_t );
+    return s;
+}
+
+void
+Snapshot::readNames()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        Var v = nextVariable();
+        bool toBePrinted = next();
+        const char* name = nextString();
+        if( name[ 0 ] != '\0' )
+        {
+            VariableNames::setName( v, name );
+            solver.addedVarName( v );
+            if( wasp::Options::printAtomTable )
+                cout << v << " " << name << endl;
+        }
+        if( toBePrinted )
+            VariableNames::setToBePrinted( v );
+    }
+}
+
+void
+Snapshot::readFrozen()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+        solver.setFrozen( nextVariable() );
+}
+
+void
+Snapshot::readEliminated()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        Var v = nextVariable();
+        unsigned int sign = next();
+        if( sign == ELIMINATED_BY_DISTRIBUTION )
+        {
+            solver.onEliminatingVariable( v, sign, NULL );
+            for( unsigned int s = POSITIVE; s <= NEGATIVE; s++ )
+            {
+                unsigned int numberOfOccurrences = next();
+                for( unsigned int j = 0; j < numberOfOccurrences; j++ )
+                {
+                    Clause* clause = nextClause();
+                    clause->markAsDeleted();
+                    solver.addClause( Literal( v, s ), clause );
+                }
+            }
+        }
+        else if( sign == POSITIVE || sign == NEGATIVE )
+            solver.onEliminatingVariable( v, sign, nextClause() );
+        else
+            WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+    }
+
+    //Eliminated variables are not propagated.
+    while( solver.hasNextVariableToPropagate() )
+        solver.getNextVariableToPropagate();
+}
+
+void
+Snapshot::readClauses()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+        solver.addClause( nextClause() );
+}
+
+void
+Snapshot::readBinaryClauses()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        Literal lit1 = nextLiteral();
+        Literal lit2 = nextLiteral();
+        solver.addClause( lit1, lit2 );
+    }
+}
+
+void
+Snapshot::readAggregates()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        uint64_t bound = next64();
+        unsigned int length = next();
+        Aggregate* aggregate = new Aggregate();
+        for( unsigned int i = 1; i <= length; i++ )
+        {
+            Literal lit = nextLiteral();
+            uint64_t weight = next64();
+            //The weight of the aggregate literal is computed by updateBound.
+            aggregate->addLiteral( lit, i == 1 ? 0 : weight );
+        }
+        aggregate->updateBound( solver, bound );
+        solver.attachAggregate( *aggregate );
+        solver.addAggregate( aggregate );
+    }
+}
+
+void
+Snapshot::readCardinalityConstraints()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        uint64_t bound = next64();
+        unsigned int length = next();
+        CardinalityConstraint* cc = new CardinalityConstraint();
+        for( unsigned int i = 0; i < length; i++ )
+            cc->addLiteral( nextLiteral() );
+        cc->setBound( bound );
+        solver.attachCardinalityConstraint( *cc );
+        solver.addCardinalityConstraint( cc );
+    }
+}
+
+void
+Snapshot::readMultiAggregates()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        MultiAggregate* multi = new MultiAggregate();
+        unsigned int length = next();
+        for( unsigned int i = 0; i < length; i++ )
+        {
+            Literal lit = nextLiteral();
+            multi->addLiteral( lit, next64() );
+        }
+        unsigned int numberOfBounds = next();
+        for( unsigned int i = 0; i < numberOfBounds; i++ )
+        {
+            Literal id = nextLiteral();
+            multi->addBound( id, next64() );
+        }
+        //Binary clauses of the aggregate are already in the snapshot.
+        multi->finalizeNoBinaryClauses( solver );
+        solver.attachMultiAggregate( *multi );
+        solver.addMultiAggregate( multi );
+    }
+}
+
+void
+Snapshot::readPseudoBooleanConstraints()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        uint64_t bound = next64();
+        unsigned int length = next();
+        PseudoBooleanConstraint* pb = new PseudoBooleanConstraint();
+        for( unsigned int i = 0; i < length; i++ )
+        {
+            Literal lit = nextLiteral();
+            pb->addLiteral( lit, next64() );
+        }
+        pb->setBound( bound );
+        if( !solver.attachPseudoBooleanConstraint( *pb ) )
+            WaspErrorMessage::errorGeneric( "Invalid snapshot: pseudo-Boolean constraint cannot be satisfied." );
+        solver.addPseudoBooleanConstraint( pb );
+    }
+}
+
+void
+Snapshot::readDisjunctions()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        DisjunctionPropagator* disjunction = new DisjunctionPropagator( nextLiteral() );
+        unsigned int length = next();
+        for( unsigned int i = 0; i < length; i++ )
+        {
+            Literal original = nextLiteral();
+            disjunction->addOriginalAndAuxLiterals( original, nextLiteral() );
+        }
+        solver.addDisjunctionPropagator( disjunction );
+        disjunction->finalize( solver );
+    }
+}
+
+void
+Snapshot::readGUSData()
+{
+    unsigned int length = next();
+    for( unsigned int i = 0; i < length; i++ )
+    {
+        unsigned int flags = next();
+        if( flags == 0 )
+        {
+            solver.addGUSData( NULL );
+            continue;
+        }
+
+        GUSData* gd = new GUSData();
+        if( flags & 2 )
+            gd->setAux();
+        GUSLists& lists = solver.gusLists;
+        FrozenLists< Literal >* literals[ 3 ] = { &lists.externalLiterals, &lists.internalLiterals, &lists.literals };
+        for( unsigned int k = 0; k < 3; k++ )
+        {
+            unsigned int n = next();
+            for( unsigned int j = 0; j < n; j++ )
+                literals[ k ]->add( i, nextLiteral() );
+        }
+        FrozenLists< Var >* vars[ 2 ] = { &lists.possiblySupportedByThis, &lists.auxVariablesSupportedByThis };
+        for( unsigned int k = 0; k < 4; k++ )
+        {
+            unsigned int n = next();
+            for( unsigned int j = 0; j < n; j++ )
+                vars[ k >> 1 ]->add( Literal( i, k & 1 ).getIndex(), nextVariable() );
+        }
+        solver.addGUSData( gd );
+    }
+    if( length > 0 )
+        solver.gusLists.freeze( length - 1 );
+}
+
+void
+Snapshot::readComponents()
+{
+    size_t end = pos + data[ pos - 1 ];
+    unsigned int numberOfComponents = next();
+    for( unsigned int i = 0; i < numberOfComponents; i++ )
+    {
+        Component* component = new Component( solver.gusDataVector, solver.gusLists, solver );
+        component->setId( i );
+        solver.cyclicComponents.push_back( component );
+        unsigned int length = next();
+        statistics( &solver, addCyclicComponent( length ) );
+        for( unsigned int j = 0; j < length; j++ )
+        {
+            Var v = nextVariable();
+            if( v >= solver.gusDataVector.size() || solver.gusDataVector[ v ] == NULL )
+                WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+            component->addVariable( v );
+            if( solver.getComponent( v ) == NULL )
+                solver.setComponent( v, component );
+            component->variableHasNoSourcePointer( v );
+        }
+        solver.addPostPropagator( component );
+    }
+
+    while( pos < end )
+    {
+        Literal lit = nextLiteral();
+        unsigned int id = next();
+        if( id >= numberOfComponents )
+            WaspErrorMessage::errorGeneric( "Malformed snapshot." );
+        solver.addPostPropagator( lit, solver.cyclicComponents[ id ] );
+    }
+}
+
+void
+Snapshot::readOptimization()
+{
+    unsigned int levels = next();
+    solver.setLevels( levels );
+    for( unsigned int level = 0; level < levels; level++ )
+    {
+        unsigned int n = next();
+        for( unsigned int i = 0; i < n; i++ )
+        {
+            Literal lit = nextLiteral();
+            uint64_t weight = next64();
+            solver.addOptimizationLiteral( lit, weight, level, next() != 0 );
+        }
+    }
+}
+
+void
+Snapshot::readHeuristic()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        Var v = nextVariable();
+        unsigned int modifier = next();
+        int bias = static_cast< int >( next() );
+        solver.addDomainHeuristic( v, modifier, bias, next() );
+    }
+}
+
+bool
+Snapshot::readUnits()
+{
+    size_t end = pos + data[ pos - 1 ];
+    while( pos < end )
+    {
+        if( !solver.addClause( nextLiteral() ) )
+        {
+            pos = end;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef WASP_SNAPSHOT_H
+#define WASP_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "Literal.h"
+
+class Clause;
+class Solver;
+
+/**
+ * Binary image of the solver after preprocessing.
+ * The file is a sequence of 32-bit words: a header (magic, version, byte
+ * order, flags, number of variables) followed by sections made of a tag, the
+ * number of words in the section and the payload. There are no pointers, so
+ * the file is mapped in memory and read in place; names are stored
+ * null-terminated and passed to VariableNames without copies.
+ * Propagators and components are rebuilt from their literals and the
+ * literals true at level 0 are propagated once everything is attached.
+ */
+class Snapshot
+{
+    public:
+        inline Snapshot( Solver& s ) : solver( s ), sectionStart( 0 ), data( NULL ), size( 0 ), pos( 0 ) {}
+
+        void write( const string& filename, unsigned int flags );
+
+        /**
+         * Rebuilds the program in an empty solver.
+         * @return the flags stored in the header
+         */
+        unsigned int read( const string& filename );
+
+    private:
+        Solver& solver;
+
+        vector< uint32_t > words;
+        size_t sectionStart;
+
+        inline void add( uint32_t word ) { words.push_back( word ); }
+        inline void add64( uint64_t word ) { words.push_back( word & 0xFFFFFFFF ); words.push_back( word >> 32 ); }
+        inline void add( Literal lit ) { words.push_back( lit.getIndex() ); }
+        void add( const Clause& clause );
+        void addString( const char* s );
+        inline void startSection( uint32_t tag ) { words.push_back( tag ); words.push_back( 0 ); sectionStart = words.size(); }
+        inline void endSection() { words[ sectionStart - 1 ] = words.size() - sectionStart; }
+
+        void writeNames();
+        void writeFrozen();
+        void writeEliminated();
+        void writeClauses();
+        void writeBinaryClauses();
+        void writePropagators();
+        void writeComponents();
+        void writeOptimization();
+        void writeHeuristic();
+        void writeUnits();
+
+        const uint32_t* data;
+        size_t size;
+        size_t pos;
+
+        unsigned int load();
+        inline uint32_t next();
+        inline uint64_t next64() { uint64_t low = next(); uint64_t high = next(); return low | ( high << 32 ); }
+        inline Var nextVariable();
+        inline Literal nextLiteral();
+        Clause* nextClause();
+        const char* nextString();
+
+        void readNames();
+        void readFrozen();
+        void readEliminated();
+        void readClauses();
+        void readBinaryClauses();
+        void readAggregates();
+        void readCardinalityConstraints();
+        void readMultiAggregates();
+        void readPseudoBooleanConstraints();
+        void readDisjunctions();
+        void readGUSData();
+        void readComponents();
+        void readOptimization();
+        void readHeuristic();
+        bool readUnits();
+};
+
+#endif
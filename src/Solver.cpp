@@ -63,6 +63,12 @@ Solver::~Solver()
         propagators.pop_back();
     }
     
+    while( !learnedPseudoBooleanConstraints.empty() )
+    {
+        delete learnedPseudoBooleanConstraints.back();
+        learnedPseudoBooleanConstraints.pop_back();
+    }
+    
     while( !disjunctionPropagators.empty() )
     {
         assert( disjunctionPropagators.back() );
@@ -413,7 +419,6 @@ Solver::solvePropagators(
             }
         }
         
-        #if defined(ENABLE_PYTHON) || defined(ENABLE_PERL)
         for( unsigned int i = 0; i < propagatorsAfterUnit.size(); i++ )
         {
             propagatorsAfterUnit[ i ]->endUnitPropagation( *this );
@@ -422,7 +427,6 @@ Solver::solvePropagators(
             else if( hasNextVariableToPropagate() )
                 goto propagationLabel;
         }
-        #endif    
         
         postPropagationLabel:;
         while( !postPropagators.empty() )
@@ -493,7 +497,6 @@ Solver::solvePropagators(
             }
         }                
         
-        #if defined(ENABLE_PYTHON) || defined(ENABLE_PERL)
         for( unsigned int i = 0; i < propagatorsAttachedToEndPropagation.size(); i++ )
         {
             propagatorsAttachedToEndPropagation[ i ]->endPropagation( *this );
@@ -502,11 +505,9 @@ Solver::solvePropagators(
             else if( hasNextVariableToPropagate() )
                 goto propagationLabel;
         }
-        #endif
         
         restartIfNecessary();
 
-        #if defined(ENABLE_PYTHON) || defined(ENABLE_PERL)
         for( unsigned int i = 0; i < propagatorsAttachedToPartialChecks.size(); i++ )
             if( !propagatorsAttachedToPartialChecks[ i ]->checkPartialInterpretation( *this ) )
             {
@@ -517,10 +518,8 @@ Solver::solvePropagators(
                 else
                     goto propagationLabel;
             }
-        #endif
     }
     
-    #if defined(ENABLE_PYTHON) || defined(ENABLE_PERL)
     for( unsigned int i = 0; i < propagatorsAttachedToCheckAnswerSet.size(); i++ )
         if( !propagatorsAttachedToCheckAnswerSet[ i ]->checkAnswerSet( *this ) )
         {
@@ -531,7 +530,6 @@ Solver::solvePropagators(
             else
                 goto propagationLabel;
         }
-    #endif    
     completeModel();
     assert_msg( getNumberOfUndefined() == 0, "Found a model with " << getNumberOfUndefined() << " undefined variables." );
     assert_msg( allClausesSatisfied(), "The model found is not correct." );
@@ -633,16 +631,84 @@ Solver::propagation(
 
 //    Vector< pair< Propagator*, int > >& wl = variablePropagators[ ( getTruthValue( variable ) >> 1 ) ];
     Vector< pair< Propagator*, PropagatorData > >& wl = getDataStructure( complement ).variablePropagators;
-    for( unsigned i = 0; i < wl.size(); ++i )
+    unsigned i = 0;
+    unsigned j = 0;
+    for( ; i < wl.size(); ++i )
     {
         if( conflictDetected() )
             break;
         Propagator* propagator = wl[ i ].first;
         assert( "Post propagator is null." && propagator != NULL );
+        propagatorDetached = false;
         bool res = propagator->onLiteralFalse( *this, complement, wl[ i ].second );        
         if( res )
             addInPropagatorsForUnroll( propagator );
+        if( !propagatorDetached )
+            wl[ j++ ] = wl[ i ];
+    }
+    
+    if( i == j )
+        return;
+    for( ; i < wl.size(); ++i )
+        wl[ j++ ] = wl[ i ];
+    wl.shrink( j );
+}
+
+void
+Solver::removePropagator(
+    Literal lit,
+    Propagator* p )
+{
+    Vector< pair< Propagator*, PropagatorData > >& wl = getDataStructure( lit ).variablePropagators;
+    unsigned j = 0;
+    for( unsigned i = 0; i < wl.size(); ++i )
+        if( wl[ i ].first != p )
+            wl[ j++ ] = wl[ i ];
+    wl.shrink( j );
+}
+
+void
+Solver::addLearnedPseudoBooleanConstraint(
+    PseudoBooleanConstraint* pb )
+{
+    if( pb == NULL )
+        return;
+
+    //A constraint violated after the backjump is discarded: the learned clause is enough.
+    if( conflictDetected() || !pb->attach( *this ) )
+    {
+        trace_msg( learning, 2, "Discarding constraint " << *pb );
+        delete pb;
+        return;
+    }
+    learnedPseudoBooleanConstraints.push_back( pb );
+    statistics( this, onLearningPseudoBooleanConstraint( pb->size() ) );
+}
+
+void
+Solver::reduceLearnedPseudoBooleanConstraints()
+{
+    assert( currentDecisionLevel == 0 );
+    trace_msg( solving, 2, "Deleting learned pseudo-Boolean constraints" );
+    unsigned int toDelete = learnedPseudoBooleanConstraints.size() / 2;
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < learnedPseudoBooleanConstraints.size(); i++ )
+    {
+        PseudoBooleanConstraint* pb = learnedPseudoBooleanConstraints[ i ];
+        bool locked = false;
+        for( unsigned int k = 0; k < pb->size() && !locked; k++ )
+            locked = isTrue( pb->getLiteral( k ) ) && getImplicant( pb->getLiteral( k ).getVariable() ) == pb;
+
+        if( i < toDelete && !locked )
+        {
+            pb->detach( *this );
+            delete pb;
+        }
+        else
+            learnedPseudoBooleanConstraints[ j++ ] = pb;
     }
+    learnedPseudoBooleanConstraints.resize( j );
+    maxLearnedPseudoBooleanConstraints *= CUTTING_PLANES_LEARNED_INCREMENT;
 }
 
 void
@@ -1095,6 +1161,12 @@ Solver::simplifyOnRestart()
     //Maybe in future we want to disable this function.
     removeSatisfied( clauses );
 
+    if( recomputeComponentsOnRestart_ )
+    {
+        recomputeCyclicComponents();
+        clearComponents();
+    }
+
     assignedVariablesAtLevelZero = variables.numberOfAssignedLiterals();
     nextValueOfPropagation = literalsInClauses + literalsInLearnedClauses;
 }
@@ -1287,7 +1359,7 @@ Solver::createCyclicComponents()
         if( size > 1 )
         {            
             statistics( this, addCyclicComponent( size ) );
-            Component* currentComponent = new Component( gusDataVector, *this );
+            Component* currentComponent = new Component( gusDataVector, gusLists, *this );
             cyclicComponents.push_back( currentComponent );
             currentComponent->setId( id++ );
             
@@ -1297,6 +1369,88 @@ Solver::createCyclicComponents()
     }
 }
 
+void
+Solver::recomputeCyclicComponents()
+{
+    assert( currentDecisionLevel == 0 );
+    if( cyclicComponents.empty() )
+        return;
+
+    DependencyGraph graph( *this );
+    vector< unsigned int > missing( numberOfVariables() + 1, 0 );
+    for( unsigned int i = 0; i < cyclicComponents.size(); i++ )
+        if( !cyclicComponents[ i ]->isRemoved() )
+            cyclicComponents[ i ]->addUndecidedDependencies( graph, missing );
+    graph.computeStrongConnectedComponents();
+
+    vector< bool > isCyclic( cyclicComponents.size(), false );
+    for( unsigned int i = 0; i < graph.numberComponents(); i++ )
+    {
+        vector< Var >& current = graph.getComponent( i );
+        if( current.size() <= 1 )
+            continue;
+        for( unsigned int j = 0; j < cyclicComponents.size(); j++ )
+            if( cyclicComponents[ j ] == getComponent( current[ 0 ] ) )
+                isCyclic[ j ] = true;
+    }
+
+    Vector< Component* > removed;
+    for( unsigned int i = 0; i < cyclicComponents.size(); i++ )
+        if( !isCyclic[ i ] && !cyclicComponents[ i ]->isRemoved() )
+            removed.push_back( cyclicComponents[ i ] );
+    if( !removed.empty() )
+        removeCyclicComponents( removed );
+}
+
+void
+Solver::removeCyclicComponents(
+    const Vector< Component* >& removed )
+{
+    assert( currentDecisionLevel == 0 );
+    Vector< PostPropagator* > postPropagatorsToRemove;
+    for( unsigned int i = 0; i < removed.size(); i++ )
+    {
+        Component* component = removed[ i ];
+        postPropagatorsToRemove.push_back( component );
+        trace_msg( unfoundedset, 1, "Component " << component->getId() << " is acyclic at level 0: removing it" );
+        statistics( this, removeComponent( component->getId() ) );
+        component->remove();
+        for( unsigned int j = 0; j < component->size(); j++ )
+            if( getComponent( component->getVariable( j ) ) == component )
+                setComponent( component->getVariable( j ), NULL );
+    }
+
+    for( Var v = 1; v <= numberOfVariables(); v++ )
+    {
+        for( unsigned int sign = POSITIVE; sign <= NEGATIVE; sign++ )
+        {
+            Vector< PostPropagator* >& wl = getDataStructure( Literal( v, sign ) ).variablePostPropagators;
+            unsigned int j = 0;
+            for( unsigned int k = 0; k < wl.size(); k++ )
+            {
+                wl[ j ] = wl[ k ];
+                if( !postPropagatorsToRemove.existElement( wl[ k ] ) )
+                    j++;
+            }
+            wl.shrink( j );
+        }
+    }
+
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < postPropagators.size(); i++ )
+    {
+        postPropagators[ j ] = postPropagators[ i ];
+        if( !postPropagatorsToRemove.existElement( postPropagators[ i ] ) )
+        {
+            j++;
+            continue;
+        }
+        postPropagators[ i ]->onRemoving();
+        postPropagators[ i ]->reset();
+    }
+    postPropagators.shrink( j );
+}
+
 HCComponent*
 Solver::createHCComponent(
     unsigned numberOfInputAtoms )
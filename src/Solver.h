@@ -49,6 +49,8 @@ using namespace std;
 #include "propagators/CardinalityConstraint.h"
 #include "weakconstraints/OptimizationProblemUtils.h"
 #include "propagators/MultiAggregate.h"
+#include "propagators/PseudoBooleanConstraint.h"
+#include "CuttingPlanes.h"
 #include "AnswerSetListener.h"
 #include "ProgramListener.h"
 #include "input/WeightConstraint.h"
@@ -89,6 +91,7 @@ struct OptimizationLiteralData
 
 class Solver
 {
+    friend class Snapshot;
     public:
         inline Solver();
         ~Solver();
@@ -168,6 +171,8 @@ class Solver
         inline void setAChoice( Literal choice );        
         
         inline bool analyzeConflict();
+        void addLearnedPseudoBooleanConstraint( PseudoBooleanConstraint* pb );
+        void reduceLearnedPseudoBooleanConstraints();
         inline void clearConflictStatus();
         inline bool performAssumptions( vector< Literal >& assumptions );
         inline bool chooseLiteral( vector< Literal >& assumptions );
@@ -250,13 +255,22 @@ class Solver
         inline void computeStrongConnectedComponents();                        
         
         void createCyclicComponents();
+
+        /**
+         * Recomputes the strongly connected components of the atoms that are
+         * not decided at level 0. Components without a cycle among these
+         * atoms are removed, since the completion is enough for them.
+         */
+        void recomputeCyclicComponents();
+        void removeCyclicComponents( const Vector< Component* >& removed );
         inline void addHCComponent( HCComponent* c ) { hcComponents.push_back( c ); }
 
         inline bool tight() const { return cyclicComponents.empty() && hcComponents.empty(); }
         inline unsigned int getNumberOfCyclicComponents() const { return cyclicComponents.size(); }
         inline Component* getCyclicComponent( unsigned int position ) { return cyclicComponents[ position ]; }
         
-        inline void addGUSData( GUSData* gd ) { gusDataVector.push_back( gd ); }        
+        inline void addGUSData( GUSData* gd ) { gusDataVector.push_back( gd ); }
+        inline GUSLists& getGUSLists() { return gusLists; }        
         
         inline void onStrengtheningClause( Clause* clause ) { satelite->onStrengtheningClause( clause ); }
         
@@ -264,11 +278,12 @@ class Solver
                
         inline void addExternalPropagator( ExternalPropagator* prop ) { assert( prop != NULL ); externalPropagators.push_back( prop ); }
         inline void endPreprocessing();
-        inline bool hasPropagators() const { return ( !tight() || !propagators.empty() || !disjunctionPropagators.empty() || !externalPropagators.empty() ); }                
+        inline bool hasPropagators() const { return ( !tight() || !propagators.empty() || !disjunctionPropagators.empty() || !externalPropagators.empty() || !learnedPseudoBooleanConstraints.empty() ); }                
         inline void addDisjunctionPropagator( DisjunctionPropagator* disj ) { assert( disj != NULL ); disjunctionPropagators.push_back( disj ); }
         inline void addAggregate( Aggregate* aggr ) { assert( aggr != NULL ); propagators.push_back( aggr ); }
         inline void addMultiAggregate( MultiAggregate* aggr ) { assert( aggr != NULL ); propagators.push_back( aggr ); }
         inline void addCardinalityConstraint ( CardinalityConstraint* cc ) { assert( cc != NULL ); propagators.push_back( cc ); }
+        inline void addPseudoBooleanConstraint( PseudoBooleanConstraint* pb ) { assert( pb != NULL ); propagators.push_back( pb ); }
         
         inline void turnOffSimplifications() { callSimplifications_ = false; }
         inline bool callSimplifications() const { return callSimplifications_; }
@@ -342,6 +357,12 @@ class Solver
         inline HCComponent* getHCComponent( Var v ) { return variables.getHCComponent( v ); }
         
         inline void addPropagator( Literal lit, Propagator* p, PropagatorData propData ) { getDataStructure( lit ).variablePropagators.push_back( pair< Propagator*, PropagatorData >( p, propData ) ); }
+        /**
+         * Called by a propagator inside onLiteralFalse: the entry that is being
+         * notified is removed from the list of the literal.
+         */
+        inline void detachCurrentPropagator() { propagatorDetached = true; }
+        void removePropagator( Literal lit, Propagator* p );
         inline void addPostPropagator( Literal lit, PostPropagator* p ) { getDataStructure( lit ).variablePostPropagators.push_back( p ); }
                 
         bool isFrozen( Var v ) const { return variables.isFrozen( v ); }
@@ -368,6 +389,7 @@ class Solver
         inline void attachAggregate( Aggregate& );
         inline void attachCardinalityConstraint( CardinalityConstraint& );
         inline void attachMultiAggregate( MultiAggregate& );
+        inline bool attachPseudoBooleanConstraint( PseudoBooleanConstraint& );
         
         inline bool isSatisfied( const Clause& clause ) const;
         inline bool allUndefined( const Clause& clause ) const;
@@ -433,6 +455,8 @@ class Solver
         inline void minimizeUnsatCoreWithProgression();
         inline void minimizeUnsatCoreWithLinearSearch();
         inline void setMinimizeUnsatCore( bool b ) { minimizeUnsatCore_ = b; }
+        inline void setCuttingPlanes( bool b ) { cuttingPlanes_ = b; }
+        inline void setRecomputeComponentsOnRestart( bool b ) { recomputeComponentsOnRestart_ = b; }
         inline void setComputeUnsatCores( bool b ) { computeUnsatCores_ = b; }
         inline const Clause* getUnsatCore() const { return unsatCore; }
         
@@ -474,6 +498,7 @@ class Solver
 //        inline void simplifyOptimizationLiterals();
         
         inline void addedVarName( Var var );
+        inline void addDomainHeuristic( Var v, unsigned int modifier, int bias, unsigned int priority ) { choiceHeuristic->addDomainHeuristic( v, modifier, bias, priority ); }
         inline void onStartingSolver()
         {
             for( unsigned int i = 0; i < externalPropagators.size(); i++ )
@@ -552,7 +577,7 @@ class Solver
         bool checkVariablesState();
         inline void setEliminated( Var v, unsigned int value, Clause* definition ) { variables.setEliminated( v, value, definition ); }        
         
-        Solver( const Solver& ) : learning( *this ), dependencyGraph( NULL )
+        Solver( const Solver& ) : learning( *this ), cuttingPlanes( *this ), dependencyGraph( NULL )
         {
 //            dependencyGraph = new DependencyGraph( *this );
             assert( "The copy constructor has been disabled." && 0 );
@@ -569,6 +594,8 @@ class Solver
         
         vector< Clause* > clauses;
         vector< Clause* > learnedClauses;
+        vector< PseudoBooleanConstraint* > learnedPseudoBooleanConstraints;
+        double maxLearnedPseudoBooleanConstraints;
         
         vector< unsigned int > unrollVector;
         
@@ -576,6 +603,7 @@ class Solver
         Reason* conflictClause;
         
         Learning learning;
+        CuttingPlanes cuttingPlanes;
         OutputBuilder* outputBuilder;        
         
         MinisatHeuristic* choiceHeuristic;
@@ -598,10 +626,12 @@ class Solver
         Vector< PostPropagator* > postPropagators;
         Vector< Propagator* > propagatorsForUnroll;
         Vector< unsigned > fromLevelToPropagators;
+        bool propagatorDetached;
         
         inline void addInPropagatorsForUnroll( Propagator* prop );
         
         vector< GUSData* > gusDataVector;
+        GUSLists gusLists;
         vector< ExternalPropagator* > externalPropagators;
         vector< Propagator* > propagators;
         vector< DisjunctionPropagator* > disjunctionPropagators;        
@@ -719,6 +749,8 @@ class Solver
         unsigned int learnedFromConflicts;                        
         bool computeUnsatCores_;
         bool minimizeUnsatCore_;
+        bool cuttingPlanes_;
+        bool recomputeComponentsOnRestart_;
         Clause* unsatCore;        
         unsigned int maxNumberOfChoices;
         unsigned int numberOfChoices;
@@ -756,9 +788,11 @@ class Solver
 Solver::Solver() 
 :
     currentDecisionLevel( 0 ),
+    maxLearnedPseudoBooleanConstraints( CUTTING_PLANES_MAX_LEARNED ),
     conflictLiteral( Literal::null ),
     conflictClause( NULL ),
     learning( *this ),        
+    cuttingPlanes( *this ),
     outputBuilder( NULL ),
     restart( NULL ),
     assignedVariablesAtLevelZero( MAXUNSIGNEDINT ),
@@ -777,6 +811,8 @@ Solver::Solver()
     learnedFromConflicts( 0 ),    
     computeUnsatCores_( false ),
     minimizeUnsatCore_( true ),
+    cuttingPlanes_( false ),
+    recomputeComponentsOnRestart_( false ),
     unsatCore( NULL ),
     maxNumberOfChoices( UINT_MAX ),
     numberOfChoices( 0 ),
@@ -795,6 +831,7 @@ Solver::Solver()
     variableDataStructures.push_back( NULL );
     variableDataStructures.push_back( NULL );
     fromLevelToPropagators.push_back( 0 );
+    propagatorDetached = false;
     choices.push_back( Literal::null );
     if( wasp::Options::heuristicPartialChecks )
         wasp::Options::forwardPartialChecks = true;
@@ -895,6 +932,7 @@ Solver::addVariableInternal()
     variables.push_back();    
     choiceHeuristic->onNewVariable( variables.numberOfVariables() );
     learning.onNewVariable();
+    cuttingPlanes.onNewVariable();
     glucoseData.onNewVariable();
     
     variableDataStructures.push_back( new DataStructures() );
@@ -1448,6 +1486,7 @@ Solver::analyzeConflict()
     if( conflictClause == NULL )
         return false;
     
+    PseudoBooleanConstraint* cuttingPlane = cuttingPlanes_ ? cuttingPlanes.onConflict( conflictLiteral, conflictClause ) : NULL;
     Clause* learnedClause = learning.onConflict( conflictLiteral, conflictClause );
     assert( "Learned clause has not been calculated." && learnedClause != NULL );
     statistics( this, onLearning( learnedClause->size() ) );
@@ -1464,7 +1503,10 @@ Solver::analyzeConflict()
         choiceHeuristic->onLearningClause( 1, learnedClause );
         releaseClause( learnedClause );
         if( !addClauseRuntime( tmpLit ) )
-            return false;        
+        {
+            delete cuttingPlane;
+            return false;
+        }
 //        assignLiteral( learnedClause->getAt( 0 ) );
 //        assert( isTrue( learnedClause->getAt( 0 ) ) );
 //        assert( !conflictDetected() );
@@ -1519,6 +1561,7 @@ Solver::analyzeConflict()
 
         clearConflictStatus();
     }
+    addLearnedPseudoBooleanConstraint( cuttingPlane );
 
     if( --deletionCounters.learnedSizeAdjustCnt == 0 )
     {
@@ -1732,7 +1775,6 @@ Solver::clearComponents()
     for( unsigned int i = 0; i < cyclicComponents.size(); i++ )
     {
         cyclicComponents[ j ] = cyclicComponents[ i ];
-        cyclicComponents[ j ]->setId( j );
         if( !cyclicComponents[ i ]->isRemoved() )
             j++;
     }
@@ -1758,8 +1800,14 @@ Solver::preprocessing()
     
     assert( satelite != NULL );
     assert( checkVariablesState() );   
-    if( callSimplifications() && !satelite->simplify() )
-        return false;
+    if( callSimplifications() )
+    {
+        statistics( this, startStage( "satelite", numberOfVariables() - numberOfAssignedLiterals(), numberOfClauses() ) );
+        bool ok = satelite->simplify();
+        statistics( this, endStage( numberOfVariables() - numberOfAssignedLiterals(), numberOfClauses() ) );
+        if( !ok )
+            return false;
+    }
 
     for( unsigned int i = 0; i < externalPropagators.size(); i++ )
     {
@@ -1773,6 +1821,7 @@ Solver::preprocessing()
         
     clearVariableOccurrences();
     attachWatches();
+    recomputeCyclicComponents();
     clearComponents();
     
     choiceHeuristic->onFinishedSimplifications();       
@@ -2173,17 +2222,14 @@ Solver::attachAggregate(
     Aggregate& aggregate )
 {    
     assert( aggregate.size() > 0 );
-    Literal aggregateLiteral = aggregate[ 1 ].getOppositeLiteral();
-    addPropagator( aggregateLiteral, &aggregate, PropagatorData( -1 ) );
-    addPropagator( aggregateLiteral.getOppositeLiteral(), &aggregate, PropagatorData( 1 ) );    
-    for( unsigned int j = 2; j <= aggregate.size(); j++ )
-    {
-        Literal lit = aggregate[ j ];
-        if( !isTrue( aggregateLiteral ) )
-            addPropagator( lit.getOppositeLiteral(), &aggregate, PropagatorData( -j ) );
-        if( !isFalse( aggregateLiteral ) )
-            addPropagator( lit, &aggregate, PropagatorData( j ) );
-    }
+    aggregate.attach( *this );
+}
+
+bool
+Solver::attachPseudoBooleanConstraint(
+    PseudoBooleanConstraint& constraint )
+{
+    return constraint.attach( *this );
 }
 
 void
@@ -2198,8 +2244,7 @@ void
 Solver::attachCardinalityConstraint(
     CardinalityConstraint& constraint )
 {    
-    for( unsigned int i = 0; i < constraint.size(); i++ )
-        addPropagator( constraint[ i ], &constraint, PropagatorData( i ) );    
+    constraint.attach( *this );
 }
 
 bool
@@ -2498,6 +2543,8 @@ Solver::restartIfNecessary()
         glucoseData.lbdQueue.fastClear();
         doRestart();
         simplifyOnRestart();
+        if( currentDecisionLevel == 0 && learnedPseudoBooleanConstraints.size() >= maxLearnedPseudoBooleanConstraints )
+            reduceLearnedPseudoBooleanConstraints();
     }
 }
 
@@ -33,6 +33,7 @@
 #include "outputBuilders/IdOutputBuilder.h"
 #include "outputBuilders/NoopOutputBuilder.h"
 #include "Enumeration.h"
+#include "Snapshot.h"
 
 void
 WaspFacade::readInput(
@@ -56,12 +57,21 @@ WaspFacade::readInput(
             dimacs.parse();
             if( dimacs.isMaxsat() )
                 d->setMaxsat();
+            snapshotFlags_ = SNAPSHOT_FLAG_DIMACS | ( dimacs.isMaxsat() ? SNAPSHOT_FLAG_MAXSAT : 0 );
             delete outputBuilder;
             outputBuilder = d;
             greetings();
             break;
         }
 
+        case ASPIF_FIRST_CHAR:
+        {
+            GringoNumericFormat gringo( solver );
+            gringo.parseAspif( in );
+            greetings();
+            break;
+        }
+
         default:
         {
             GringoNumericFormat gringo( solver );
@@ -73,6 +83,39 @@ WaspFacade::readInput(
     }
 }
 
+void
+WaspFacade::loadSnapshot(
+    const string& filename )
+{
+    Snapshot snapshot( solver );
+    snapshotFlags_ = snapshot.read( filename );
+    if( snapshotFlags_ & SNAPSHOT_FLAG_DIMACS )
+    {
+        DimacsOutputBuilder* d = new DimacsOutputBuilder();
+        if( snapshotFlags_ & SNAPSHOT_FLAG_MAXSAT )
+            d->setMaxsat();
+        solver.setOutputBuilder( d );
+        delete outputBuilder;
+        outputBuilder = d;
+    }
+    greetings();
+}
+
+void
+WaspFacade::dumpSnapshot(
+    const string& filename )
+{
+    if(runtime_) { WaspErrorMessage::errorGeneric("Calling method dumpSnapshot after solve."); return; }
+    runtime_ = true;
+
+    if(disableVE_) solver.disableVariableElimination();
+    unsigned int flags = snapshotFlags_ & ~SNAPSHOT_FLAG_INCOHERENT;
+    if(!solver.preprocessing()) flags |= SNAPSHOT_FLAG_INCOHERENT;
+
+    Snapshot snapshot( solver );
+    snapshot.write( filename, flags );
+}
+
 void
 WaspFacade::solve()
 {
@@ -232,7 +275,6 @@ WaspFacade::addPseudoBooleanConstraint(
     uint64_t sumOfWeights = 0;
     unsigned int j = 0;
     for(unsigned int i = 0; i < lits.size(); i++) {
-        lits[i]=lits[j];    weights[i]=weights[j];
         addVariables(lits[i].getVariable());        
         if(solver.hasBeenEliminated(lits[i].getVariable())) WaspErrorMessage::errorGeneric("Trying to add a deleted variable to aggregate.");
         if(solver.isFalse(lits[i]) || weights[i] == 0) continue;
@@ -248,6 +290,7 @@ WaspFacade::addPseudoBooleanConstraint(
         else if(differentWeights != weights[i])
             differentWeights = UINT64_MAX-1;
         sumOfWeights += weights[i];
+        lits[j]=lits[i];    weights[j]=weights[i];
         j++;
     }
     lits.resize(j);    weights.resize(j);
@@ -256,13 +299,7 @@ WaspFacade::addPseudoBooleanConstraint(
     
     mergesort(0, lits.size()-1, lits, weights);
         
-    if(runtime_) solver.addVariableRuntime();
-    else solver.addVariable();
-    Var aggrId = solver.numberOfVariables();
-    solver.setFrozen( aggrId );
-    Aggregate* aggregate = new Aggregate();
-    Literal aggregateLiteral = solver.getLiteral( aggrId );
-    aggregate->addLiteral(aggregateLiteral.getOppositeLiteral(), 0);    
+    PseudoBooleanConstraint* pb = new PseudoBooleanConstraint();
     #ifndef NDEBUG
     uint64_t previousWeight = UINT64_MAX;
     #endif    
@@ -270,22 +307,14 @@ WaspFacade::addPseudoBooleanConstraint(
         assert(lits[i].getVariable() <= solver.numberOfVariables());
         assert(solver.isUndefined(lits[i].getVariable()));
         assert(!solver.hasBeenEliminated(lits[i].getVariable()));
-        aggregate->addLiteral( lits[i], weights[i] );
+        pb->addLiteral( lits[i], weights[i] );
         solver.setFrozen( lits[i].getVariable() );
-        assert_msg( previousWeight >= weights[i], "Literals must be sorted in increasing order" );
+        assert_msg( previousWeight >= weights[i], "Literals must be sorted in decreasing order" );
         assert( previousWeight = weights[i] );        
     }
-    assert( aggregate->size() >= 1 );    
-    bool res = solver.addClauseRuntime(aggregateLiteral);
-    if(!res) { ok_ = false; return false; }        
-    
-    if( !aggregate->updateBound( solver, bound ) ) { delete aggregate; ok_ = false; return false; }
-
-    solver.attachAggregate( *aggregate );
-    solver.addAggregate( aggregate );
-    
-    assert( solver.isTrue( aggregateLiteral ) );
-    aggregate->onLiteralFalse( solver, aggregateLiteral.getOppositeLiteral(), 1 );
+    assert( pb->size() >= 1 );    
+    if( !pb->setBound( bound ) || !solver.attachPseudoBooleanConstraint( *pb ) ) { delete pb; ok_ = false; return false; }
+    solver.addPseudoBooleanConstraint( pb );
     
     if( solver.conflictDetected() ) { ok_ = false; return false; }        
     return ok_;
@@ -51,6 +51,18 @@ class WaspFacade
          * @param i
          */        
         void readInput( istream& i );
+
+        /**
+         * Reads a program previously saved by dumpSnapshot.
+         * @param filename
+         */
+        void loadSnapshot( const string& filename );
+
+        /**
+         * Preprocesses the program and saves the result, so that it can be solved later without parsing and simplifying it again.
+         * @param filename
+         */
+        void dumpSnapshot( const string& filename );
         
         /**
          * Default solving method, solving algorithm is selected according to the input program (computation of answer sets, computation of cautious consequences, computation of optimum answer sets).
@@ -223,6 +235,8 @@ class WaspFacade
         void setRestartsPolicy( RESTARTS_POLICY, unsigned int threshold );
 
         inline void setMinimizeUnsatCore( bool value ) { solver.setMinimizeUnsatCore( value ); }        
+        inline void setCuttingPlanes( bool value ) { solver.setCuttingPlanes( value ); }
+        inline void setRecomputeComponentsOnRestart( bool value ) { solver.setRecomputeComponentsOnRestart( value ); }
         
         /**
          * Return the cost of the answer set for a specific level
@@ -254,6 +268,7 @@ class WaspFacade
         bool ok_;
         bool disableVE_;
         unsigned int nbCalls;
+        unsigned int snapshotFlags_;
         
         OutputBuilder* outputBuilder;
         OutputBuilder* tmpOutputBuilder;
@@ -264,7 +279,7 @@ class WaspFacade
         inline void addVariables(Var addedVar);
 };
 
-WaspFacade::WaspFacade() : runtime_(false), ok_(true), disableVE_(false), nbCalls(0), tmpOutputBuilder(NULL)
+WaspFacade::WaspFacade() : runtime_(false), ok_(true), disableVE_(false), nbCalls(0), snapshotFlags_(0), tmpOutputBuilder(NULL)
 {   
     outputBuilder = new WaspOutputBuilder();
     solver.setOutputBuilder(outputBuilder);    
@@ -21,6 +21,7 @@
 #include "../util/WaspErrorMessage.h"
 #include "../util/WaspOptions.h"
 #include "../Solver.h"
+#include "../interpreters/MyNativeInterpreter.h"
 #include "../interpreters/MyPerlInterpreter.h"
 #include "../interpreters/MyPythonInterpreter.h"
 
@@ -33,9 +34,12 @@ ExternalHeuristic::ExternalHeuristic( Solver& s, char* filename, unsigned int in
         interpreter = new MyPythonInterpreter( filename, scriptDirectory, wasp::Options::callPyFinalize );
     else if( interpr == PERL_INTERPRETER )
         interpreter = new MyPerlInterpreter( filename, scriptDirectory );
+    else if( interpr == NATIVE_INTERPRETER )
+        interpreter = new MyNativeInterpreter( filename, scriptDirectory );
     else
         WaspErrorMessage::errorGeneric( "Unsupported interpreter" );    
-    bool check_choiceVars = interpreter->checkMethod( method_selectLiteral );
+    check_selectLiterals = interpreter->checkMethod( method_selectLiterals );
+    bool check_choiceVars = check_selectLiterals || interpreter->checkMethod( method_selectLiteral );
     
     if( !check_choiceVars )
         WaspErrorMessage::errorGeneric( "Method " + string( method_selectLiteral ) + " is mandatory." );
@@ -45,6 +49,7 @@ ExternalHeuristic::ExternalHeuristic( Solver& s, char* filename, unsigned int in
     check_onLearningClause = interpreter->checkMethod( method_onLearningClause );
     check_onLitInImportantClause = interpreter->checkMethod( method_onLitInImportantClause );
     check_onLitInvolvedInConflict = interpreter->checkMethod( method_onLitInvolvedInConflict );
+    check_onLitsInvolvedInConflict = interpreter->checkMethod( method_onLitsInvolvedInConflict );
     check_onLoopFormula = interpreter->checkMethod( method_onLoopFormula );
     check_onNewClause = interpreter->checkMethod( method_onNewClause );
     check_onRestart = interpreter->checkMethod( method_onRestart );
@@ -56,6 +61,9 @@ ExternalHeuristic::ExternalHeuristic( Solver& s, char* filename, unsigned int in
     
     status = CHOICE;    
     value = 0;
+    queuePosition = 0;
+    queueLevel = 0;
+    levelOfNextChoice = 0;
 }
 
 ExternalHeuristic::~ExternalHeuristic() { delete interpreter; }
@@ -92,8 +100,67 @@ void ExternalHeuristic::selectLiteral()
     }
 }
 
+void ExternalHeuristic::nextQueuedChoice()
+{
+    unsigned int level = solver.getCurrentDecisionLevel();
+    if( level < queueLevel )
+    {
+        choiceQueue.clear();
+        queuePosition = 0;
+    }
+    else if( level < levelOfNextChoice )
+        queuePosition = choiceQueue.size();
+
+    if( queuePosition == 0 )
+    {
+        vector< int > result;
+        interpreter->callListMethod( method_selectLiterals, result );
+        readQueue( result );
+        queueLevel = level;
+        queuePosition = choiceQueue.size();
+    }
+
+    assert( queuePosition > 0 );
+    status = choiceQueue[ --queuePosition ].first;
+    value = choiceQueue[ queuePosition ].second;
+    //Directives are executed once, choices are read again after a backjump.
+    if( status != CHOICE )
+        choiceQueue.resize( queuePosition );
+}
+
+void ExternalHeuristic::readQueue( const vector< int >& result )
+{
+    //The elements of the list are reversed: each element is 0, status and, except for restarts, value.
+    choiceQueue.clear();
+    unsigned int i = 0;
+    while( i < result.size() )
+    {
+        if( result[ i ] != 0 || i + 1 >= result.size() )
+            WaspErrorMessage::errorGeneric( error_selectLiterals );
+
+        int s = result[ i + 1 ];
+        if( s == DO_RESTART )
+        {
+            choiceQueue.push_back( pair< int, int >( s, 0 ) );
+            i += 2;
+            continue;
+        }
+        if( ( s != CHOICE && s != FALLBACK_HEURISTIC && s != UNROLL ) || i + 2 >= result.size() )
+            WaspErrorMessage::errorGeneric( error_selectLiterals );
+        choiceQueue.push_back( pair< int, int >( s, result[ i + 2 ] ) );
+        i += 3;
+    }
+    if( choiceQueue.empty() )
+        WaspErrorMessage::errorGeneric( error_selectLiterals );
+}
+
 void ExternalHeuristic::onConflictProtected()
 {
+    if( !conflictLiterals.empty() )
+    {
+        interpreter->callVoidMethod( method_onLitsInvolvedInConflict, conflictLiterals );
+        conflictLiterals.clear();
+    }
     if( check_onConflict ) interpreter->callVoidMethod( method_onConflict );
 }
 
@@ -229,7 +296,8 @@ void ExternalHeuristic::onUnfoundedSet( const Vector< Var >& unfoundedSet )
 
 void ExternalHeuristic::onLitInvolvedInConflictProtected( Literal lit )
 {
-    if( check_onLitInvolvedInConflict ) interpreter->callVoidMethod( method_onLitInvolvedInConflict, lit.getId() );    
+    if( check_onLitsInvolvedInConflict ) conflictLiterals.push_back( lit.getId() );
+    else if( check_onLitInvolvedInConflict ) interpreter->callVoidMethod( method_onLitInvolvedInConflict, lit.getId() );    
 }
 
 void ExternalHeuristic::onRestart()
@@ -249,7 +317,10 @@ Literal ExternalHeuristic::makeAChoiceProtected()
     
     while( true )
     {
-        selectLiteral();        
+        if( check_selectLiterals )
+            nextQueuedChoice();
+        else
+            selectLiteral();
         switch( status )
         {
             case CHOICE:
@@ -262,8 +333,12 @@ Literal ExternalHeuristic::makeAChoiceProtected()
                 {
                     Literal lit = Literal::createLiteralFromInt( value );
                     if( solver.isUndefined( lit ) )
+                    {
+                        levelOfNextChoice = solver.getCurrentDecisionLevel() + 1;
                         return lit;
-                    else if( solver.isFalse( lit ) )
+                    }
+                    //Queued choices may be falsified by the previous ones.
+                    else if( solver.isFalse( lit ) && !check_selectLiterals )
                         WaspErrorMessage::errorGeneric( "Contradiction in the choice" );
                 }
                 //All choices given are already true or the variable has been eliminated;
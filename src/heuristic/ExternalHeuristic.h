@@ -22,6 +22,7 @@
 //Learning
 #define method_onConflict "onConflict"
 #define method_onLitInvolvedInConflict "onLitInvolvedInConflict"
+#define method_onLitsInvolvedInConflict "onLitsInvolvedInConflict"
 #define method_onLearningClause "onLearningClause"
 #define method_onLitInImportantClause "onLitInImportantClause"
 
@@ -32,6 +33,7 @@
 
 //Choice
 #define method_selectLiteral "selectLiteral"
+#define method_selectLiterals "selectLiterals"
 
 //ASP
 #define method_onUnfoundedSet "onUnfoundedSet"
@@ -43,11 +45,16 @@
 #define method_signFallback "signFallback"
 
 #define error_selectLiteral "Method " method_selectLiteral " is not well-formed: see the documentation for more information"
+#define error_selectLiterals "Method " method_selectLiterals " is not well-formed: see the documentation for more information"
 #define error_initfallback "Method " method_initFallback " is not well-formed: see the documentation for more information"
 #define error_factorfallback "Method " method_factorFallback " is not well-formed: see the documentation for more information"
 
 #include "../interpreters/Interpreter.h"
 #include "MinisatHeuristic.h"
+#include <utility>
+#include <vector>
+using namespace std;
+
 class ExternalHeuristic : public MinisatHeuristic
 {
     public:        
@@ -80,8 +87,34 @@ class ExternalHeuristic : public MinisatHeuristic
         void signFallback();
         
         void selectLiteral();
-        
+
+        /**
+         * Sets status and value to the next element of the queue returned by
+         * selectLiterals, which is called again when the queue is empty or the
+         * solver backjumped below the level in which the queue was computed.
+         * After a backjump to a higher level the queue is read again from the
+         * first choice that has not been consumed.
+         */
+        void nextQueuedChoice();
+        void readQueue( const vector< int >& result );
+
         Interpreter* interpreter;
+
+        /**
+         * Pairs (status, value) returned by selectLiterals, the next is the last one.
+         */
+        vector< pair< int, int > > choiceQueue;
+        unsigned int queuePosition;
+        unsigned int queueLevel;
+        unsigned int levelOfNextChoice;
+
+        /**
+         * Literals involved in the current conflict, sent by onConflict.
+         */
+        vector< int > conflictLiterals;
+
+        bool check_selectLiterals;
+        bool check_onLitsInvolvedInConflict;
         
         bool check_onConflict;
         bool check_onDeletion;
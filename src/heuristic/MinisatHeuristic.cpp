@@ -18,7 +18,9 @@
 
 #include "MinisatHeuristic.h"
 
+#include <algorithm>
 #include <cassert>
+#include <unordered_set>
 #include "../Literal.h"
 #include "../Solver.h"
 
@@ -155,6 +157,53 @@ MinisatHeuristic::simplifyVariablesAtLevelZero()
 	}    
 }
 
+void
+MinisatHeuristic::applyDomainHeuristics()
+{
+    if( domainHeuristics.empty() )
+        return;
+
+    //For each atom and modifier only the directive with the highest priority is applied.
+    stable_sort( domainHeuristics.begin(), domainHeuristics.end(), higherPriority );
+    unordered_set< uint64_t > applied;
+    for( unsigned int i = 0; i < domainHeuristics.size(); i++ )
+    {
+        const DomainHeuristic& h = domainHeuristics[ i ];
+        if( !applied.insert( ( ( uint64_t ) h.var << 3 ) | h.modifier ).second )
+            continue;
+
+        trace_msg( heuristic, 1, "Domain heuristic " << h.modifier << " with bias " << h.bias << " for variable " << h.var );
+        switch( h.modifier )
+        {
+            case DOMAIN_HEURISTIC_SIGN:
+                if( h.bias != 0 )
+                    setSign( h.bias > 0 ? h.var : -h.var );
+                break;
+
+            case DOMAIN_HEURISTIC_TRUE:
+                setSign( h.var );
+                break;
+
+            case DOMAIN_HEURISTIC_FALSE:
+                setSign( -h.var );
+                break;
+
+            case DOMAIN_HEURISTIC_FACTOR:
+                if( h.bias > 0 )
+                    setFactor( h.var, h.bias );
+                break;
+
+            case DOMAIN_HEURISTIC_INIT:
+                init( h.var, h.bias );
+                break;
+
+            default:
+                break;
+        }
+    }
+    domainHeuristics.clear();
+}
+
 void MinisatHeuristic::computeScore( Var v, unsigned int& score )
 {
     switch( wasp::Options::initMinisatHeuristic )
@@ -83,7 +83,7 @@ class MinisatHeuristic
 
         inline void onNewVariable( Var v );
         inline void onNewVariableRuntime( Var v );
-        inline void onFinishedSimplifications() { simplifyVariablesAtLevelZero(); onFinishedSimplificationsProtected(); }
+        inline void onFinishedSimplifications() { simplifyVariablesAtLevelZero(); applyDomainHeuristics(); onFinishedSimplificationsProtected(); }
         inline void onUnrollingVariable( Var v );
         
         inline void onLitInvolvedInConflict( Literal lit ) { variableBumpActivity( lit.getVariable() ); onLitInvolvedInConflictProtected( lit ); }
@@ -102,6 +102,13 @@ class MinisatHeuristic
         inline void addPreferredChoice( Literal lit );
         inline void removePrefChoices();
         
+        /**
+         * Domain heuristic modifiers (#heuristic) are applied once simplifications are over.
+         */
+        inline void addDomainHeuristic( Var v, unsigned int modifier, int bias, unsigned int priority );
+        inline unsigned int numberOfDomainHeuristics() const { return domainHeuristics.size(); }
+        inline void getDomainHeuristic( unsigned int i, Var& v, unsigned int& modifier, int& bias, unsigned int& priority ) const;
+        
         Literal makeAChoice();
 
     protected:
@@ -123,6 +130,7 @@ class MinisatHeuristic
         void randomChoice();
         inline void variableDecayActivity(){ trace_msg( heuristic, 1, "Calling decay activity" ); variableIncrement *= variableDecay; }
         void simplifyVariablesAtLevelZero();
+        void applyDomainHeuristics();
         inline bool bumpActivity( Var var ){ assert( var < act.size() ); return ( ( act[ var ] += variableIncrement ) > 1e100 ); }
 
         
@@ -141,6 +149,16 @@ class MinisatHeuristic
         Vector< Activity > act;
         vector< Preference > vars;        
 
+        struct DomainHeuristic
+        {
+            Var var;
+            unsigned int modifier;
+            int bias;
+            unsigned int priority;
+        };
+        vector< DomainHeuristic > domainHeuristics;
+        static bool higherPriority( const DomainHeuristic& h1, const DomainHeuristic& h2 ) { return h1.priority > h2.priority; }
+
         Var chosenVariable;
         Heap< ActivityComparator > heap;
         HeapLiterals< LiteralActivityComparator > preferredChoices;                
@@ -260,6 +278,38 @@ MinisatHeuristic::addPreferredChoice(
     preferredChoices.pushNoCheck( lit );
 }
 
+void
+MinisatHeuristic::getDomainHeuristic(
+    unsigned int i,
+    Var& v,
+    unsigned int& modifier,
+    int& bias,
+    unsigned int& priority ) const
+{
+    assert( i < domainHeuristics.size() );
+    const DomainHeuristic& h = domainHeuristics[ i ];
+    v = h.var;
+    modifier = h.modifier;
+    bias = h.bias;
+    priority = h.priority;
+}
+
+void
+MinisatHeuristic::addDomainHeuristic(
+    Var v,
+    unsigned int modifier,
+    int bias,
+    unsigned int priority )
+{
+    assert( v < vars.size() );
+    DomainHeuristic h;
+    h.var = v;
+    h.modifier = modifier;
+    h.bias = bias;
+    h.priority = priority;
+    domainHeuristics.push_back( h );
+}
+
 void
 MinisatHeuristic::removePrefChoices()
 {
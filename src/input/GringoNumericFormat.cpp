@@ -8,6 +8,7 @@
 #include "../propagators/HCComponent.h"
 #include "../propagators/ExternalPropagator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <unordered_set>
@@ -22,6 +23,30 @@ GringoNumericFormat::parse( istream& i )
     this->parse( input );
 }
 
+void
+GringoNumericFormat::parseAspif( istream& i )
+{
+    Istream input( i );
+    this->parseAspif( input );
+}
+
+void
+GringoNumericFormat::checkProgramSize()
+{
+    uint64_t value = normalRules.size();
+    if( value != 0 && value % 10000000 == 0 )
+    {
+        cleanData();
+    }
+    
+    if( solver.callSimplifications() && solver.numberOfClauses() + value > 1000000 )
+    {
+        solver.turnOffSimplifications();
+        if( !usedDictionary )
+            bodiesDictionary.disable();
+    }
+}
+
 void
 GringoNumericFormat::parse(
     Istream& input )
@@ -29,7 +54,6 @@ GringoNumericFormat::parse(
     trace_msg( parser, 1, "Start parsing..." );
     bool loop = true;
 
-    uint64_t value = 0;
     statistics( &solver, startParsing() );
     addExternalPropagators();
     while( loop )
@@ -37,19 +61,7 @@ GringoNumericFormat::parse(
         unsigned int type;
         input.read( type );
 
-        value = normalRules.size();
-        if( value != 0 && value % 10000000 == 0 )
-        {
-            cleanData();
-        }
-        
-        if( solver.callSimplifications() && solver.numberOfClauses() + value > 1000000 )
-        {
-            solver.turnOffSimplifications();
-            if( !usedDictionary )
-                bodiesDictionary.disable();
-        }
-
+        checkProgramSize();
         switch( type )
         {
         case GRINGO_NORMAL_RULE_ID:
@@ -95,9 +107,119 @@ GringoNumericFormat::parse(
     readTrueAtoms( input );
     readFalseAtoms( input );
     readErrorNumber( input );
-    propagate();
+    processProgram();
+}
 
-    simplify();    
+void
+GringoNumericFormat::parseAspif(
+    Istream& input )
+{
+    trace_msg( parser, 1, "Start parsing aspif..." );
+    string header;
+    unsigned int major, minor, revision;
+    input.read( header );
+    input.read( major );
+    input.read( minor );
+    input.read( revision );
+    if( header != ASPIF_HEADER || major != 1 )
+        WaspErrorMessage::errorDuringParsing( "Unsupported aspif version." );
+    skipLine( input );
+
+    bool loop = true;
+    map< int, WeightConstraint* > minimize;
+    statistics( &solver, startParsing() );
+    addExternalPropagators();
+    while( loop )
+    {
+        unsigned int type;
+        input.read( type );
+
+        checkProgramSize();
+        switch( type )
+        {
+        case ASPIF_RULE:
+            readAspifRule( input );
+            break;
+
+        case ASPIF_MINIMIZE:
+            readAspifMinimize( input, minimize );
+            break;
+
+        case ASPIF_PROJECTION:
+        {
+            unsigned int size;
+            int atom;
+            input.read( size );
+            while( size-- > 0 )
+                input.read( atom );
+            break;
+        }
+
+        case ASPIF_OUTPUT:
+            readAspifOutput( input );
+            break;
+
+        case ASPIF_EXTERNAL:
+            readAspifExternal( input );
+            break;
+
+        case ASPIF_ASSUMPTION:
+            readAspifAssumption( input );
+            break;
+
+        case ASPIF_HEURISTIC:
+            readAspifHeuristic( input );
+            break;
+
+        case ASPIF_COMMENT:
+            skipLine( input );
+            break;
+
+        case ASPIF_END:
+            loop = false;
+            break;
+
+        case ASPIF_EDGE:
+            WaspErrorMessage::errorDuringParsing( "Acyclicity constraints are not supported." );
+            break;
+
+        case ASPIF_THEORY:
+            WaspErrorMessage::errorDuringParsing( "Theory atoms are not supported." );
+            break;
+
+        default:
+            WaspErrorMessage::errorDuringParsing( "Unsupported statement type." );
+            break;
+        }
+
+        if( solver.conflictDetected() )
+            return;
+            
+        propagate();
+    }
+
+    //Priorities are sorted in increasing order, as the levels of optimization rules.
+    for( map< int, WeightConstraint* >::iterator it = minimize.begin(); it != minimize.end(); ++it )
+        addOptimizationRule( it->second );
+    processProgram();
+}
+
+void
+GringoNumericFormat::runStage(
+    const char* name,
+    void ( GringoNumericFormat::*stage )() )
+{
+    trace_msg( parser, 1, "Starting stage " << name );
+    statistics( &solver, startStage( name, solver.numberOfVariables() - solver.numberOfAssignedLiterals(), solver.numberOfClauses() ) );
+    ( this->*stage )();
+    statistics( &solver, endStage( solver.numberOfVariables() - solver.numberOfAssignedLiterals(), solver.numberOfClauses() ) );
+}
+
+void
+GringoNumericFormat::processProgram()
+{
+    runStage( "propagate", &GringoNumericFormat::propagate );
+    runStage( "simplify", &GringoNumericFormat::simplify );
     
     bodiesDictionary.clear();
 
@@ -108,22 +230,19 @@ GringoNumericFormat::parse(
         solver.turnOffSimplifications();
     
     statistics( &solver, endParsing() );    
-    statistics( &solver, startSCCs() );
     if( numberOfDisjunctiveRules == 0 || wasp::Options::shiftStrategy == SHIFT_NAIVE )
-        computeSCCs();
+        runStage( "sccs", &GringoNumericFormat::computeSCCs );
     else
-        computeSCCsDisjunctive();    
-    statistics( &solver, endSCCs() );
+        runStage( "sccs", &GringoNumericFormat::computeSCCsDisjunctive );
     trace_msg( parser, 1, "Program is " << ( solver.tight() ? "tight" : "not tight" ) );
     
     if( !solver.tight() )
-        computeGusStructures();        
-    addWeightConstraints();
-    addOptimizationRules();
+        runStage( "gus structures", &GringoNumericFormat::computeGusStructures );
+    runStage( "weight constraints", &GringoNumericFormat::addWeightConstraints );
+    runStage( "optimization rules", &GringoNumericFormat::addOptimizationRules );
     clearDataStructures();    
-    statistics( &solver, startCompletion() );
-    computeCompletion();    
-    statistics( &solver, endCompletion() );
+    runStage( "completion", &GringoNumericFormat::computeCompletion );
+    addHeuristicDirectives();
     solver.endPreprocessing();
     for( unsigned int i = 0; i < multiAggregates.size(); i++ )
         multiAggregates[ i ]->finalize( solver );   
@@ -137,45 +256,335 @@ GringoNumericFormat::parse(
 }
 
 void
-GringoNumericFormat::readChoiceRule(
+GringoNumericFormat::skipLine(
+    Istream& input )
+{
+    char c = input.previous();
+    while( c != '\n' && c != EOF )
+        c = input.next();
+}
+
+unsigned
+GringoNumericFormat::getAspifAtom(
+    int lit )
+{
+    unsigned atom = lit > 0 ? lit : -lit;
+    if( atom >= aspifAtoms.size() )
+        aspifAtoms.resize( atom + 1, 0 );
+    if( aspifAtoms[ atom ] == 0 )
+        aspifAtoms[ atom ] = createAuxAtom();
+    return aspifAtoms[ atom ];
+}
+
+unsigned
+GringoNumericFormat::createAuxAtom()
+{
+    unsigned id = atomData.size();
+    createStructures( id );
+    return id;
+}
+
+void
+GringoNumericFormat::readAspifLiterals(
+    Istream& input,
+    unsigned howMany,
+    Vector< unsigned >& negativeLiterals,
+    Vector< unsigned >& positiveLiterals )
+{
+    negativeLiterals.clear();
+    positiveLiterals.clear();
+    int lit;
+    while( howMany-- > 0 )
+    {
+        input.read( lit );
+        if( lit < 0 )
+            negativeLiterals.push_back( getAspifAtom( lit ) );
+        else
+            positiveLiterals.push_back( getAspifAtom( lit ) );
+    }
+}
+
+void
+GringoNumericFormat::readAspifBody(
+    Istream& input )
+{
+    unsigned int type, size;
+    input.read( type );
+    if( type == ASPIF_NORMAL_BODY )
+    {
+        input.read( size );
+        readAspifLiterals( input, size, negativeBodyBuffer, positiveBodyBuffer );
+        return;
+    }
+
+    if( type != ASPIF_WEIGHT_BODY )
+        WaspErrorMessage::errorDuringParsing( "Unsupported body type." );
+
+    int lowerBound, lit, weight;
+    input.read( lowerBound );
+    input.read( size );
+    negativeBodyBuffer.clear();
+    positiveBodyBuffer.clear();
+    negativeWeightsBuffer.clear();
+    positiveWeightsBuffer.clear();
+    bool isCount = true;
+    uint64_t sum = 0;
+    while( size-- > 0 )
+    {
+        input.read( lit );
+        input.read( weight );
+        if( weight < 0 )
+            WaspErrorMessage::errorDuringParsing( "Negative weights are not supported." );
+        if( weight == 0 )
+            continue;
+        if( weight != 1 )
+            isCount = false;
+        sum += weight;
+        if( lit < 0 )
+        {
+            negativeBodyBuffer.push_back( getAspifAtom( lit ) );
+            negativeWeightsBuffer.push_back( weight );
+        }
+        else
+        {
+            positiveBodyBuffer.push_back( getAspifAtom( lit ) );
+            positiveWeightsBuffer.push_back( weight );
+        }
+    }
+
+    if( lowerBound <= 0 )
+    {
+        negativeBodyBuffer.clear();
+        positiveBodyBuffer.clear();
+        return;
+    }
+
+    //The weight body is replaced by an auxiliary atom defined by a weight constraint.
+    unsigned aux = createAuxAtom();
+    if( sum < static_cast< uint64_t >( lowerBound ) )
+        addFalseVariable( aux );
+    else if( isCount )
+        addCount( aux, lowerBound, negativeBodyBuffer, positiveBodyBuffer );
+    else
+        addSum( aux, lowerBound, negativeBodyBuffer, positiveBodyBuffer, negativeWeightsBuffer, positiveWeightsBuffer );
+
+    negativeBodyBuffer.clear();
+    positiveBodyBuffer.clear();
+    positiveBodyBuffer.push_back( aux );
+}
+
+void
+GringoNumericFormat::readAspifRule(
     Istream& input )
 {
-    unsigned headSize, bodySize, negativeSize;
+    unsigned int headType, headSize;
+    input.read( headType );
     input.read( headSize );
-    unsigned* head = new unsigned[ headSize ];
-    for( unsigned i = 0; i < headSize; )
+    headAtomsBuffer.clear();
+    int atom;
+    while( headSize-- > 0 )
+    {
+        input.read( atom );
+        headAtomsBuffer.push_back( getAspifAtom( atom ) );
+    }
+    readAspifBody( input );
+
+    if( headType == ASPIF_CHOICE_HEAD )
     {
-        input.read( head[ i ] );
-        createStructures( head[ i ] );
-        if( solver.isFalse( head[ i ] ) )
-            --headSize;
+        if( !headAtomsBuffer.empty() )
+            addChoiceRule( headAtomsBuffer, negativeBodyBuffer, positiveBodyBuffer );
+    }
+    else if( headType != ASPIF_DISJUNCTIVE_HEAD )
+        WaspErrorMessage::errorDuringParsing( "Unsupported head type." );
+    else if( headAtomsBuffer.empty() )
+        addConstraint( negativeBodyBuffer, positiveBodyBuffer );
+    else if( headAtomsBuffer.size() == 1 )
+        addNormalRule( headAtomsBuffer[ 0 ], negativeBodyBuffer, positiveBodyBuffer );
+    else
+        addDisjunctiveRule( headAtomsBuffer, negativeBodyBuffer, positiveBodyBuffer );
+}
+
+void
+GringoNumericFormat::readAspifMinimize(
+    Istream& input,
+    map< int, WeightConstraint* >& minimize )
+{
+    int priority, lit, weight;
+    unsigned int size;
+    input.read( priority );
+    input.read( size );
+    statistics( &solver, readWeakConstraints( size ) );
+    negativeBodyBuffer.clear();
+    positiveBodyBuffer.clear();
+    negativeWeightsBuffer.clear();
+    positiveWeightsBuffer.clear();
+    while( size-- > 0 )
+    {
+        input.read( lit );
+        input.read( weight );
+        //A negative weight is moved on the complementary literal: the cost is shifted by a constant.
+        if( weight < 0 )
+        {
+            lit = -lit;
+            weight = -weight;
+        }
+
+        if( lit < 0 )
+        {
+            negativeBodyBuffer.push_back( getAspifAtom( lit ) );
+            negativeWeightsBuffer.push_back( weight );
+        }
         else
-            ++i;
+        {
+            positiveBodyBuffer.push_back( getAspifAtom( lit ) );
+            positiveWeightsBuffer.push_back( weight );
+        }
     }
-    readBodySize( input, bodySize, negativeSize );
-    if( headSize == 0 )
+
+    WeightConstraint*& weightConstraintRule = minimize[ priority ];
+    if( weightConstraintRule == NULL )
+        weightConstraintRule = new WeightConstraint( 0, 1 );
+    addOptimizationLiterals( weightConstraintRule, negativeBodyBuffer, positiveBodyBuffer, negativeWeightsBuffer, positiveWeightsBuffer );
+}
+
+void
+GringoNumericFormat::readAspifOutput(
+    Istream& input )
+{
+    unsigned int length, size;
+    input.read( length );
+    nameBuffer.clear();
+    while( length-- > 0 )
+        nameBuffer.push_back( input.next() );
+    input.read( size );
+    readAspifLiterals( input, size, negativeBodyBuffer, positiveBodyBuffer );
+
+    unsigned atom;
+    if( negativeBodyBuffer.empty() && positiveBodyBuffer.size() == 1 && VariableNames::isHidden( positiveBodyBuffer[ 0 ] ) )
+        atom = positiveBodyBuffer[ 0 ];
+    else
     {
-        skipLiterals( input, bodySize );
-        delete[] head;
+        //Terms and complex conditions are shown by means of an auxiliary atom.
+        atom = createAuxAtom();
+        addNormalRule( atom, negativeBodyBuffer, positiveBodyBuffer );
+    }
+    setAtomName( atom, nameBuffer.c_str() );
+}
+
+void
+GringoNumericFormat::readAspifExternal(
+    Istream& input )
+{
+    int lit;
+    unsigned int value;
+    input.read( lit );
+    input.read( value );
+    unsigned atom = getAspifAtom( lit );
+    solver.setFrozen( atom );
+    if( value != ASPIF_EXTERNAL_FREE && value != ASPIF_EXTERNAL_TRUE )
         return;
+
+    headAtomsBuffer.clear();
+    headAtomsBuffer.push_back( atom );
+    negativeBodyBuffer.clear();
+    positiveBodyBuffer.clear();
+    addChoiceRule( headAtomsBuffer, negativeBodyBuffer, positiveBodyBuffer );
+    if( value == ASPIF_EXTERNAL_TRUE )
+        addTrueVariable( atom );
+}
+
+void
+GringoNumericFormat::readAspifAssumption(
+    Istream& input )
+{
+    unsigned int size;
+    input.read( size );
+    readAspifLiterals( input, size, negativeBodyBuffer, positiveBodyBuffer );
+    for( unsigned int i = 0; i < negativeBodyBuffer.size(); i++ )
+        addFalseVariable( negativeBodyBuffer[ i ] );
+    for( unsigned int i = 0; i < positiveBodyBuffer.size(); i++ )
+        addTrueVariable( positiveBodyBuffer[ i ] );
+}
+
+void
+GringoNumericFormat::readAspifHeuristic(
+    Istream& input )
+{
+    unsigned int modifier, priority, size;
+    int atom, bias;
+    input.read( modifier );
+    input.read( atom );
+    input.read( bias );
+    input.read( priority );
+    input.read( size );
+
+    HeuristicDirective* directive = new HeuristicDirective();
+    directive->atom = getAspifAtom( atom );
+    directive->modifier = modifier;
+    directive->bias = bias;
+    directive->priority = priority;
+    readAspifLiterals( input, size, directive->negativeCondition, directive->positiveCondition );
+    solver.setFrozen( directive->atom );
+    heuristicDirectives.push_back( directive );
+}
+
+void
+GringoNumericFormat::addHeuristicDirectives()
+{
+    for( unsigned int i = 0; i < heuristicDirectives.size(); i++ )
+    {
+        HeuristicDirective* directive = heuristicDirectives[ i ];
+        bool holds = true;
+        for( unsigned int j = 0; j < directive->negativeCondition.size(); j++ )
+            if( !solver.isFalse( directive->negativeCondition[ j ] ) )
+                holds = false;
+        for( unsigned int j = 0; j < directive->positiveCondition.size(); j++ )
+            if( !solver.isTrue( directive->positiveCondition[ j ] ) )
+                holds = false;
+
+        trace_msg( parser, 2, "Heuristic directive on atom " << directive->atom << ( holds ? "" : " ignored: its condition is not true" ) );
+        if( holds )
+            solver.addDomainHeuristic( directive->atom, directive->modifier, directive->bias, directive->priority );
+        delete directive;
     }
+    heuristicDirectives.clear();
+}
+
+void
+GringoNumericFormat::readChoiceRule(
+    Istream& input )
+{
+    unsigned headSize;
+    input.read( headSize );
+    readAtoms( input, headSize, headAtomsBuffer );
+    readBody( input );
+    addChoiceRule( headAtomsBuffer, negativeBodyBuffer, positiveBodyBuffer );
+}
+
+void
+GringoNumericFormat::addChoiceRule(
+    const Vector< unsigned >& headAtoms,
+    const Vector< unsigned >& negativeBody,
+    const Vector< unsigned >& positiveBody )
+{
+    Vector< unsigned > head;
+    for( unsigned i = 0; i < headAtoms.size(); ++i )
+        if( !solver.isFalse( headAtoms[ i ] ) )
+            head.push_back( headAtoms[ i ] );
+
+    if( head.empty() )
+        return;
     
     ++readNormalRule_numberOfCalls;
     Rule* rule = new Rule( head[ 0 ] );
-    unsigned tmp;
-    while( negativeSize-- > 0 )
+    for( unsigned i = 0; i < negativeBody.size(); ++i )
     {
-        --bodySize;
-        input.read( tmp );
-        createStructures( tmp );
-        
+        unsigned tmp = negativeBody[ i ];
         if( atomData[ tmp ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
             continue;
         if( solver.isTrue( tmp ) )
         {
             delete rule;
-            skipLiterals( input, bodySize );
-            delete[] head;
             return;
         }
         else if( solver.isUndefined( tmp ) )
@@ -184,18 +593,14 @@ GringoNumericFormat::readChoiceRule(
             atomData[ tmp ].readNormalRule_negativeLiterals = readNormalRule_numberOfCalls;
         }
     }
-    while( bodySize-- > 0 )
+    for( unsigned i = 0; i < positiveBody.size(); ++i )
     {
-        input.read( tmp );
-        createStructures( tmp );
-
+        unsigned tmp = positiveBody[ i ];
         if( atomData[ tmp ].readNormalRule_positiveLiterals == readNormalRule_numberOfCalls )
             continue;
         if( solver.isFalse( tmp ) || tmp == head[ 0 ] || atomData[ tmp ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
         {
             delete rule;
-            skipLiterals( input, bodySize );
-            delete[] head;
             return;
         }
         else 
@@ -210,7 +615,7 @@ GringoNumericFormat::readChoiceRule(
     rule->addDoubleNegLiteral( head[ 0 ] );
 
     statistics( &solver, readChoiceRule() );
-    for( unsigned i = 1; i < headSize; ++i )
+    for( unsigned i = 1; i < head.size(); ++i )
     {
         if( atomData[ head[ i ] ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
             continue;
@@ -224,7 +629,6 @@ GringoNumericFormat::readChoiceRule(
         delete rule;
     else
         add( rule, true, 0 );
-    delete[] head;    
 }
 
 void
@@ -233,58 +637,47 @@ GringoNumericFormat::readDisjunctiveRule(
 {
     unsigned headSize = 0;
     input.read( headSize );
-    unsigned* head = new unsigned[ headSize ];
+    readAtoms( input, headSize, headAtomsBuffer );
+    readBody( input );
+    addDisjunctiveRule( headAtomsBuffer, negativeBodyBuffer, positiveBodyBuffer );
+}
+
+void
+GringoNumericFormat::addDisjunctiveRule(
+    const Vector< unsigned >& headAtoms,
+    const Vector< unsigned >& negativeBody,
+    const Vector< unsigned >& positiveBody )
+{
+    Vector< unsigned > head;
     ++readNormalRule_numberOfCalls;    
-    for( unsigned i = 0; i < headSize; )
+    for( unsigned i = 0; i < headAtoms.size(); ++i )
     {        
-        input.read( head[ i ] );
-        createStructures( head[ i ] );
-        if( solver.isFalse( head[ i ] ) )
-            --headSize;        
-        else if( atomData[ head[ i ] ].isSupported() )
-        {
-            skipLiterals( input, headSize - i - 1 );
-            unsigned bodySize, negativeSize;
-            readBodySize( input, bodySize, negativeSize );
-            skipLiterals( input, bodySize );
-            delete[] head;
+        unsigned tmp = headAtoms[ i ];
+        if( solver.isFalse( tmp ) )
+            continue;
+        if( atomData[ tmp ].isSupported() )
             return;
-        }
-        else
-        {   
-            if( atomData[ head[ i ] ].readNormalRule_headAtoms == readNormalRule_numberOfCalls )
-                --headSize;
-            else
-            {
-                atomData[ head[ i ] ].readNormalRule_headAtoms = readNormalRule_numberOfCalls;
-                ++i;
-            }
+        if( atomData[ tmp ].readNormalRule_headAtoms != readNormalRule_numberOfCalls )
+        {
+            atomData[ tmp ].readNormalRule_headAtoms = readNormalRule_numberOfCalls;
+            head.push_back( tmp );
         }
     }
-    if( headSize == 0 )
+    if( head.empty() )
     {
-        readConstraint( input );
-        delete[] head;
+        addConstraint( negativeBody, positiveBody );
         return;
     }
     
-    unsigned bodySize, negativeSize;
-    readBodySize( input, bodySize, negativeSize );
     Rule* rule = new Rule();
-    unsigned tmp;
-    while( negativeSize-- > 0 )
+    for( unsigned i = 0; i < negativeBody.size(); ++i )
     {
-        --bodySize;
-        input.read( tmp );
-        createStructures( tmp );
-        
+        unsigned tmp = negativeBody[ i ];
         if( atomData[ tmp ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
             continue;
         if( solver.isTrue( tmp ) )
         {
             delete rule;
-            skipLiterals( input, bodySize );
-            delete[] head;
             return;
         }
         else if( solver.isUndefined( tmp ) )
@@ -293,18 +686,14 @@ GringoNumericFormat::readDisjunctiveRule(
             atomData[ tmp ].readNormalRule_negativeLiterals = readNormalRule_numberOfCalls;
         }
     }
-    while( bodySize-- > 0 )
+    for( unsigned i = 0; i < positiveBody.size(); ++i )
     {
-        input.read( tmp );
-        createStructures( tmp );
-
+        unsigned tmp = positiveBody[ i ];
         if( atomData[ tmp ].readNormalRule_positiveLiterals == readNormalRule_numberOfCalls )
             continue;
         if( solver.isFalse( tmp ) || atomData[ tmp ].readNormalRule_headAtoms == readNormalRule_numberOfCalls || atomData[ tmp ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
         {
             delete rule;
-            skipLiterals( input, bodySize );
-            delete[] head;
             return;
         }
         else 
@@ -321,7 +710,7 @@ GringoNumericFormat::readDisjunctiveRule(
     // remove head atoms appearing in negative body
     {
         unsigned j = 0;
-        for( unsigned i = 0; i < headSize; ++i )
+        for( unsigned i = 0; i < head.size(); ++i )
         {
             head[ j ] = head[ i ];
             if( atomData[ head[ i ] ].readNormalRule_negativeLiterals != readNormalRule_numberOfCalls )
@@ -331,16 +720,16 @@ GringoNumericFormat::readDisjunctiveRule(
                 ++j;
             }
         }
-        headSize = j;
+        head.shrink( j );
     }
     
-    if( headSize == 0 )
+    if( head.empty() )
     {
         bodyToConstraint( rule );        
         delete rule;
         statistics( &solver, readConstraint() );
     }
-    else if( headSize == 1 )
+    else if( head.size() == 1 )
     {
         if( rule->literals.size() == 0 )
         {
@@ -357,13 +746,12 @@ GringoNumericFormat::readDisjunctiveRule(
     }
     else
     {
-        for( unsigned i = 0; i < headSize; ++i )
+        for( unsigned i = 0; i < head.size(); ++i )
             rule->addHeadAtom( head[ i ] );        
         add( rule, false, numberOfTrueHeadAtoms );
         numberOfDisjunctiveRules++;
         statistics( &solver, readDisjunctiveRule() );
     }
-    delete[] head;
 }
 
 void
@@ -371,7 +759,6 @@ GringoNumericFormat::readOptimizationRule(
     Istream& input )
 {
     unsigned int size, negativeSize, tmp = 0;
-    uint64_t weight = 0;
     
     input.read( tmp );
     assert( tmp == 0 );
@@ -382,73 +769,55 @@ GringoNumericFormat::readOptimizationRule(
     if( size < negativeSize )
         WaspErrorMessage::errorDuringParsing( "Size must be greater than or equal to negative size." );
     
-    unsigned int counter = 0;
-    WeightConstraint* weightConstraintRule = new WeightConstraint( 0, UINT64_MAX );
-    
-    Vector< int64_t > tmps;
-    Vector< uint64_t > weights;
-    while( counter < negativeSize )
-    {
-        input.read( tmp );
-        createStructures( tmp );
-        ++counter;
-        tmps.push_back( -tmp );
-    }
-    while( counter < size )
-    {
-        input.read( tmp );
-        createStructures( tmp );
-        tmps.push_back( tmp );
-        ++counter;
-    }
+    readAtoms( input, negativeSize, negativeBodyBuffer );
+    readAtoms( input, size - negativeSize, positiveBodyBuffer );
+    readWeights( input, negativeSize, negativeWeightsBuffer );
+    readWeights( input, size - negativeSize, positiveWeightsBuffer );
 
-    uint64_t bound = 1;
-    counter = 0;
-    while( counter < negativeSize )
-    {        
-        input.read( weight );
-        weights.push_back( weight );
-        bound += weight;
-        ++counter;
-    }
-    while( counter < size )
+    WeightConstraint* weightConstraintRule = new WeightConstraint( 0, 1 );
+    addOptimizationLiterals( weightConstraintRule, negativeBodyBuffer, positiveBodyBuffer, negativeWeightsBuffer, positiveWeightsBuffer );
+    statistics( &solver, readWeakConstraints( size ) );
+    addOptimizationRule( weightConstraintRule );
+}
+
+void
+GringoNumericFormat::addOptimizationLiterals(
+    WeightConstraint* weightConstraintRule,
+    const Vector< unsigned >& negativeLiterals,
+    const Vector< unsigned >& positiveLiterals,
+    const Vector< uint64_t >& negativeWeights,
+    const Vector< uint64_t >& positiveWeights )
+{
+    assert( negativeLiterals.size() == negativeWeights.size() );
+    assert( positiveLiterals.size() == positiveWeights.size() );
+    //The bound is updated first, since weights greater than the bound are truncated.
+    uint64_t bound = weightConstraintRule->getBound();
+    for( unsigned int i = 0; i < negativeWeights.size(); i++ )
+        bound += negativeWeights[ i ];
+    for( unsigned int i = 0; i < positiveWeights.size(); i++ )
+        bound += positiveWeights[ i ];
+    weightConstraintRule->setBound( bound );
+
+    for( unsigned int i = 0; i < negativeLiterals.size(); i++ )
     {
-        input.read( weight );
-        weights.push_back( weight );
-        bound += weight;
-        ++counter;
+        uint64_t weight = negativeWeights[ i ];
+        if( weight > 0 )
+        {
+            weightConstraintRule->addNegativeLiteral( negativeLiterals[ i ] );
+            weightConstraintRule->addNegativeLiteralWeight( weight );
+        }
     }
-    
-    assert( tmps.size() == weights.size() );
-    for( unsigned int i = 0; i < tmps.size(); i++ )
+    for( unsigned int i = 0; i < positiveLiterals.size(); i++ )
     {
-        int64_t id = tmps[ i ];
-        assert( id != 0 );
-        uint64_t weight = weights[ i ];
+        uint64_t weight = positiveWeights[ i ];
         if( weight > 0 )
         {
-            if( id < 0 )
-            {
-                weightConstraintRule->addNegativeLiteral( -id );
-                weightConstraintRule->addNegativeLiteralWeight( weight );
-            }
-            else
-            {
-                weightConstraintRule->addPositiveLiteral( id );
-                weightConstraintRule->addPositiveLiteralWeight( weight );
-            }
+            weightConstraintRule->addPositiveLiteral( positiveLiterals[ i ] );
+            weightConstraintRule->addPositiveLiteralWeight( weight );
         }
-//        else
-//        {
-//            //Quick fix
-//            wasp::Options::stratification = false;
-//        }
     }
         
     assert( weightConstraintRule->sameSizeOfInternalVectors() );
-    weightConstraintRule->setBound( bound );
-    statistics( &solver, readWeakConstraints( size ) );
-    addOptimizationRule( weightConstraintRule );
 }
 
 void
@@ -458,21 +827,24 @@ GringoNumericFormat::readNormalRule(
     unsigned head;
     input.read( head );
     createStructures( head );
+    readBody( input );
+    addNormalRule( head, negativeBodyBuffer, positiveBodyBuffer );
+}
 
+void
+GringoNumericFormat::addNormalRule(
+    unsigned head,
+    const Vector< unsigned >& negativeBody,
+    const Vector< unsigned >& positiveBody )
+{
     if( solver.isFalse( head ) )
-        readConstraint( input );
+        addConstraint( negativeBody, positiveBody );
+    else if( atomData[ head ].isSupported() )
+        return;
+    else if( negativeBody.empty() && positiveBody.empty() )
+        addFact( head );
     else
-    {
-        unsigned int bodySize, negativeSize;
-        readBodySize( input, bodySize, negativeSize );
-
-        if( atomData[ head ].isSupported() )
-            skipLiterals( input, bodySize );
-        else if( bodySize == 0 )
-            addFact( head );
-        else
-            readNormalRule( input, head, bodySize, negativeSize );
-    }
+        addNormalRuleWithBody( head, negativeBody, positiveBody );
 }
 
 void
@@ -489,26 +861,55 @@ GringoNumericFormat::readBodySize(
 }
 
 void
-GringoNumericFormat::skipLiterals(
+GringoNumericFormat::readBody(
+    Istream& input )
+{
+    unsigned bodySize, negativeSize;
+    readBodySize( input, bodySize, negativeSize );
+    readAtoms( input, negativeSize, negativeBodyBuffer );
+    readAtoms( input, bodySize - negativeSize, positiveBodyBuffer );
+}
+
+void
+GringoNumericFormat::readAtoms(
     Istream& input,
-    unsigned howMany )
+    unsigned howMany,
+    Vector< unsigned >& atoms )
 {
+    atoms.clear();
     unsigned tmp;
     while( howMany-- > 0 )
+    {
         input.read( tmp );
+        createStructures( tmp );
+        atoms.push_back( tmp );
+    }
 }
 
 void
-GringoNumericFormat::readNormalRule(
+GringoNumericFormat::readWeights(
     Istream& input,
+    unsigned howMany,
+    Vector< uint64_t >& weights )
+{
+    weights.clear();
+    uint64_t tmp;
+    while( howMany-- > 0 )
+    {
+        input.read( tmp );
+        weights.push_back( tmp );
+    }
+}
+
+void
+GringoNumericFormat::addNormalRuleWithBody(
     unsigned head,
-    unsigned bodySize,
-    unsigned negativeSize )
+    const Vector< unsigned >& negativeBody,
+    const Vector< unsigned >& positiveBody )
 {
     assert( !solver.isFalse( head ) );
     assert( !atomData[ head ].isSupported() );
-    assert( bodySize >= negativeSize );
-    assert( bodySize >= 1 );
+    assert( negativeBody.size() + positiveBody.size() >= 1 );
 
     readNormalRule_numberOfCalls++;
     assert( readNormalRule_numberOfCalls != 0 );
@@ -518,13 +919,9 @@ GringoNumericFormat::readNormalRule(
     Rule* rule = new Rule( head );
     bool firing = true;
     
-    unsigned tmp = 0;
-    while( negativeSize-- > 0 )
+    for( unsigned i = 0; i < negativeBody.size(); ++i )
     {
-        --bodySize;
-        input.read( tmp );
-        
-        createStructures( tmp );
+        unsigned tmp = negativeBody[ i ];
         bodiesDictionary.addElement( -tmp );
         
         if( atomData[ tmp ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
@@ -532,7 +929,6 @@ GringoNumericFormat::readNormalRule(
         if( solver.isTrue( tmp ) )
         {
             delete rule;
-            skipLiterals( input, bodySize );
             bodiesDictionary.endInsertion();
             return;
         }
@@ -543,11 +939,9 @@ GringoNumericFormat::readNormalRule(
             firing = false;
         }
     }
-    while( bodySize-- > 0 )
+    for( unsigned i = 0; i < positiveBody.size(); ++i )
     {
-        input.read( tmp );
-        createStructures( tmp );
-        
+        unsigned tmp = positiveBody[ i ];
         bodiesDictionary.addElement( tmp );
         
         if( atomData[ tmp ].readNormalRule_positiveLiterals == readNormalRule_numberOfCalls )
@@ -555,7 +949,6 @@ GringoNumericFormat::readNormalRule(
         if( solver.isFalse( tmp ) || tmp == head || atomData[ tmp ].readNormalRule_negativeLiterals == readNormalRule_numberOfCalls )
         {
             delete rule;
-            skipLiterals( input, bodySize );
             bodiesDictionary.endInsertion();
             return;
         }
@@ -601,37 +994,24 @@ GringoNumericFormat::readNormalRule(
 }
 
 void
-GringoNumericFormat::readConstraint(
-    Istream& input )
+GringoNumericFormat::addConstraint(
+    const Vector< unsigned >& negativeBody,
+    const Vector< unsigned >& positiveBody )
 {
-    unsigned  bodySize, negativeSize, tmp = 0;
-    input.read( bodySize );
-    input.read( negativeSize );
-
-    if( bodySize < negativeSize )
-        WaspErrorMessage::errorDuringParsing( "Body size must be greater than or equal to negative size." );
-
-    Clause* clause = solver.newClause( bodySize );
-    while( negativeSize-- > 0 )
+    Clause* clause = solver.newClause( negativeBody.size() + positiveBody.size() );
+    for( unsigned i = 0; i < negativeBody.size(); ++i )
     {
-        --bodySize;
-        input.read( tmp );
-        createStructures( tmp );
-        if( !addUndefinedLiteral( clause, Literal( tmp, POSITIVE ) ) )
+        if( !addUndefinedLiteral( clause, Literal( negativeBody[ i ], POSITIVE ) ) )
         {
             solver.releaseClause( clause );
-            skipLiterals( input, bodySize );
             return;
         }
     }
-    while( bodySize-- > 0 )
+    for( unsigned i = 0; i < positiveBody.size(); ++i )
     {
-        input.read( tmp );
-        createStructures( tmp );
-        if( !addUndefinedLiteral( clause, Literal( tmp, NEGATIVE ) ) )
+        if( !addUndefinedLiteral( clause, Literal( positiveBody[ i ], NEGATIVE ) ) )
         {
             solver.releaseClause( clause );
-            skipLiterals( input, bodySize );
             return;
         }
     }
@@ -650,7 +1030,7 @@ void
 GringoNumericFormat::readCount(
     Istream& input )
 {
-    unsigned int id, bound, size, negativeSize, tmp = 0;
+    unsigned int id, bound, size, negativeSize;
     input.read( id );
     input.read( size );
     input.read( negativeSize );
@@ -662,32 +1042,29 @@ GringoNumericFormat::readCount(
         WaspErrorMessage::errorDuringParsing( "Size must be greater than or equal to negative size." );
     }
     
-    if( size < bound )
+    readAtoms( input, negativeSize, negativeBodyBuffer );
+    readAtoms( input, size - negativeSize, positiveBodyBuffer );
+    addCount( id, bound, negativeBodyBuffer, positiveBodyBuffer );
+}
+
+void
+GringoNumericFormat::addCount(
+    unsigned int id,
+    uint64_t bound,
+    const Vector< unsigned >& negativeLiterals,
+    const Vector< unsigned >& positiveLiterals )
+{
+    if( negativeLiterals.size() + positiveLiterals.size() < bound )
     {
-        while( size-- > 0 )
-        {
-            input.read( tmp );
-            createStructures( tmp );
-        }
         solver.addClause( Literal( id, NEGATIVE ) );
         return;
     }
-    assert( size >= bound );        
 
     WeightConstraint* weightConstraintRule = new WeightConstraint( id, bound );    
-    while( negativeSize-- > 0 )
-    {
-        --size;
-        input.read( tmp );
-        createStructures( tmp );
-        weightConstraintRule->addNegativeLiteralCount( tmp );
-    }
-    while( size-- > 0 )
-    {
-        input.read( tmp );
-        createStructures( tmp );
-        weightConstraintRule->addPositiveLiteralCount( tmp );
-    }
+    for( unsigned i = 0; i < negativeLiterals.size(); ++i )
+        weightConstraintRule->addNegativeLiteralCount( negativeLiterals[ i ] );
+    for( unsigned i = 0; i < positiveLiterals.size(); ++i )
+        weightConstraintRule->addPositiveLiteralCount( positiveLiterals[ i ] );
     
     assert( weightConstraintRule->sameSizeOfInternalVectors() );
     add( weightConstraintRule );
@@ -702,7 +1079,7 @@ void
 GringoNumericFormat::readSum(
     Istream& input )
 {
-    unsigned int id, bound, size, negativeSize, tmp = 0;
+    unsigned int id, bound, size, negativeSize;
     input.read( id );
     input.read( bound );
     input.read( size );
@@ -715,50 +1092,35 @@ GringoNumericFormat::readSum(
         WaspErrorMessage::errorDuringParsing( "Size must be greater than or equal to negative size." );
     }
     
+    readAtoms( input, negativeSize, negativeBodyBuffer );
+    readAtoms( input, size - negativeSize, positiveBodyBuffer );
+    readWeights( input, negativeSize, negativeWeightsBuffer );
+    readWeights( input, size - negativeSize, positiveWeightsBuffer );
+    addSum( id, bound, negativeBodyBuffer, positiveBodyBuffer, negativeWeightsBuffer, positiveWeightsBuffer );
+}
+
+void
+GringoNumericFormat::addSum(
+    unsigned int id,
+    uint64_t bound,
+    const Vector< unsigned >& negativeLiterals,
+    const Vector< unsigned >& positiveLiterals,
+    const Vector< uint64_t >& negativeWeights,
+    const Vector< uint64_t >& positiveWeights )
+{
+    assert( negativeLiterals.size() == negativeWeights.size() );
+    assert( positiveLiterals.size() == positiveWeights.size() );
     WeightConstraint* weightConstraintRule = new WeightConstraint( id, bound );
     
-    unsigned int counter = 0;
-    unsigned int previousWeight = 0;
-    
-    while( counter < negativeSize )
-    {
-        input.read( tmp );
-        createStructures( tmp );
-        weightConstraintRule->addNegativeLiteral( tmp );
-        ++counter;
-    }
-    while( counter < size )
-    {
-        input.read( tmp );
-        createStructures( tmp );
-        weightConstraintRule->addPositiveLiteral( tmp );
-        ++counter;
-    }
-        
-    counter = 0;
-    while( counter < negativeSize )
+    for( unsigned i = 0; i < negativeLiterals.size(); ++i )
     {
-        input.read( tmp );
-        if( tmp > bound )
-            tmp = bound;
-        weightConstraintRule->addNegativeLiteralWeight( tmp );
-        ++counter;
-        if( previousWeight == 0 )
-            previousWeight = tmp;
-        else if( previousWeight != tmp )
-            previousWeight = MAXUNSIGNEDINT;            
+        weightConstraintRule->addNegativeLiteral( negativeLiterals[ i ] );
+        weightConstraintRule->addNegativeLiteralWeight( min( negativeWeights[ i ], bound ) );
     }
-    while( counter < size )
+    for( unsigned i = 0; i < positiveLiterals.size(); ++i )
     {
-        input.read( tmp );
-        if( tmp > bound )
-            tmp = bound;
-        weightConstraintRule->addPositiveLiteralWeight( tmp );
-        ++counter;
-        if( previousWeight == 0 )
-            previousWeight = tmp;
-        else if( previousWeight != tmp )
-            previousWeight = MAXUNSIGNEDINT;
+        weightConstraintRule->addPositiveLiteral( positiveLiterals[ i ] );
+        weightConstraintRule->addPositiveLiteralWeight( min( positiveWeights[ i ], bound ) );
     }
   
     assert( weightConstraintRule->sameSizeOfInternalVectors() );
@@ -1030,14 +1392,7 @@ GringoNumericFormat::readAtomsTable(
     {
         createStructures( nextAtom );
         input.getline( name, 1024 );
-        VariableNames::setName( nextAtom, name );
-        solver.addedVarName( nextAtom );
-        if( wasp::Options::printAtomTable )
-            cout << nextAtom << " " << name << endl;
-        trace_msg( parser, 6, "Set name " << name << " for atom " << nextAtom );
-        
-        if( wasp::Options::queryAlgorithm != NO_QUERY )
-            solver.setFrozen( nextAtom );
+        setAtomName( nextAtom, name );
         input.read( nextAtom );        
     }
     
@@ -1045,6 +1400,21 @@ GringoNumericFormat::readAtomsTable(
         cout << "% Atoms table: end" << endl; 
 }
 
+void
+GringoNumericFormat::setAtomName(
+    unsigned id,
+    const char* name )
+{
+    VariableNames::setName( id, name );
+    solver.addedVarName( id );
+    if( wasp::Options::printAtomTable )
+        cout << id << " " << name << endl;
+    trace_msg( parser, 6, "Set name " << name << " for atom " << id );
+    
+    if( wasp::Options::queryAlgorithm != NO_QUERY )
+        solver.setFrozen( id );
+}
+
 void
 GringoNumericFormat::readTrueAtoms(
     Istream& input )
@@ -1337,6 +1707,7 @@ GringoNumericFormat::computeGusStructures()
         component->addInternalLiteralForVariable( variable, literal.getOppositeLiteral() );        
     }
     auxs.clearAndDelete();
+    solver.getGUSLists().freeze( solver.numberOfVariables() );
 }
 
 void
@@ -2868,9 +3239,9 @@ GringoNumericFormat::weightConstraintToAggregate(
         solver.setFrozen( lit.getVariable() );
     }
 
-    solver.attachAggregate( *aggregate ); 
     assert( aggregate->size() > 0 );
     aggregate->updateBound( solver, weightConstraintRule->getBound() );
+    solver.attachAggregate( *aggregate ); 
 
     if( solver.isFalse( aggregateLiteral ) )
         aggregate->onLiteralFalse( solver, aggregateLiteral, -1 );
@@ -2880,6 +3251,199 @@ GringoNumericFormat::weightConstraintToAggregate(
     return aggregate;
 }
 
+PseudoBooleanConstraint*
+GringoNumericFormat::weightConstraintToPseudoBooleanConstraint( 
+    WeightConstraint* weightConstraintRule )
+{
+    assert( solver.isTrue( weightConstraintRule->getId() ) );
+    PseudoBooleanConstraint* pb = new PseudoBooleanConstraint();
+    for( unsigned int j = 0; j < weightConstraintRule->size(); j++ )
+    {
+        Literal lit = solver.getLiteral( weightConstraintRule->getLiteral( j ) );
+        assert( solver.isUndefined( lit ) );
+        pb->addLiteral( lit, weightConstraintRule->getWeight( j ) );
+        solver.setFrozen( lit.getVariable() );
+    }
+
+    assert( pb->size() > 0 );
+    #ifndef NDEBUG
+    bool res =
+    #endif
+    pb->setBound( weightConstraintRule->getBound() );
+    assert( res );
+    pb->sort();
+    #ifndef NDEBUG
+    res =
+    #endif
+    solver.attachPseudoBooleanConstraint( *pb );
+    assert( res );
+    return pb;
+}
+
+#define BDD_TRUE -1
+#define BDD_FALSE -2
+
+static bool
+heavierLiteralFirst(
+    const pair< uint64_t, int >& e1,
+    const pair< uint64_t, int >& e2 )
+{
+    return e1.first > e2.first;
+}
+
+static int
+getBddNode(
+    unsigned int level,
+    uint64_t residual,
+    const vector< uint64_t >& suffixSums,
+    map< pair< unsigned int, uint64_t >, int >& ids,
+    Vector< unsigned int >& nodeLevels,
+    Vector< uint64_t >& nodeResiduals )
+{
+    if( residual == 0 )
+        return BDD_TRUE;
+    if( suffixSums[ level ] < residual )
+        return BDD_FALSE;
+
+    pair< unsigned int, uint64_t > key( level, residual );
+    map< pair< unsigned int, uint64_t >, int >::iterator it = ids.find( key );
+    if( it != ids.end() )
+        return it->second;
+
+    int id = nodeLevels.size();
+    ids[ key ] = id;
+    nodeLevels.push_back( level );
+    nodeResiduals.push_back( residual );
+    return id;
+}
+
+void
+GringoNumericFormat::addBddClause(
+    Literal lit1,
+    Literal lit2,
+    Literal lit3 )
+{
+    Clause* clause = solver.newClause( 3 );
+    clause->addLiteral( lit1 );
+    clause->addLiteral( lit2 );
+    if( lit3 != Literal::null )
+        clause->addLiteral( lit3 );
+    trace_msg( parser, 5, "Adding clause: " << *clause );
+    solver.cleanAndAddClause( clause );
+}
+
+bool
+GringoNumericFormat::weightConstraintToClauses(
+    WeightConstraint* weightConstraintRule )
+{
+    if( wasp::Options::aggregatesEncoding == AGGREGATES_ENCODING_PROPAGATOR || weightConstraintRule->size() == 0 )
+        return false;
+
+    //The cost of the encoding is the number of nodes of the BDD, which grows
+    //with the bound and with the number of different weights. In auto mode
+    //the propagator is kept if the BDD is large or much larger than the aggregate.
+    unsigned int maxNodes = AGGREGATES_ENCODING_MAX_NODES;
+    if( wasp::Options::aggregatesEncoding == AGGREGATES_ENCODING_AUTO )
+        maxNodes = min( ( unsigned int ) AGGREGATES_ENCODING_AUTO_MAX_NODES, AGGREGATES_ENCODING_AUTO_NODES_PER_LITERAL * weightConstraintRule->size() );
+
+    uint64_t bound = weightConstraintRule->getBound();
+    vector< pair< uint64_t, int > > elements;
+    for( unsigned int j = 0; j < weightConstraintRule->size(); j++ )
+        elements.push_back( pair< uint64_t, int >( min( weightConstraintRule->getWeight( j ), bound ), weightConstraintRule->getLiteral( j ) ) );
+    stable_sort( elements.begin(), elements.end(), heavierLiteralFirst );
+
+    vector< uint64_t > suffixSums( elements.size() + 1, 0 );
+    for( int i = elements.size() - 1; i >= 0; i-- )
+        suffixSums[ i ] = suffixSums[ i + 1 ] + elements[ i ].first;
+    if( bound == 0 || suffixSums[ 0 ] < bound )
+        return false;
+
+    //Node k is true iff the literals from nodeLevels[ k ] on reach nodeResiduals[ k ].
+    //Its children are the nodes reached if the literal is true (high) or false (low).
+    map< pair< unsigned int, uint64_t >, int > ids;
+    Vector< unsigned int > nodeLevels;
+    Vector< uint64_t > nodeResiduals;
+    Vector< int > high;
+    Vector< int > low;
+    getBddNode( 0, bound, suffixSums, ids, nodeLevels, nodeResiduals );
+    for( unsigned int k = 0; k < nodeLevels.size(); k++ )
+    {
+        unsigned int level = nodeLevels[ k ];
+        uint64_t residual = nodeResiduals[ k ];
+        uint64_t weight = elements[ level ].first;
+        high.push_back( getBddNode( level + 1, residual > weight ? residual - weight : 0, suffixSums, ids, nodeLevels, nodeResiduals ) );
+        low.push_back( getBddNode( level + 1, residual, suffixSums, ids, nodeLevels, nodeResiduals ) );
+        if( nodeLevels.size() > maxNodes )
+        {
+            trace_msg( parser, 3, "The BDD of " << *weightConstraintRule << " has more than " << maxNodes << " nodes: using a propagator" );
+            return false;
+        }
+    }
+
+    trace_msg( parser, 2, "Replacing " << *weightConstraintRule << " by a BDD with " << nodeLevels.size() << " nodes" );
+    Literal aggregateLiteral = solver.getLiteral( weightConstraintRule->getId() );
+    solver.setFrozen( aggregateLiteral.getVariable() );
+    for( unsigned int i = 0; i < elements.size(); i++ )
+        solver.setFrozen( solver.getLiteral( elements[ i ].second ).getVariable() );
+
+    //If the aggregate literal is assigned, the nodes on the path of high (true)
+    //or low (false) children from the root have its value: no variable is created
+    //for them, so that the encoding adds no unit clause.
+    vector< bool > sameAsRoot( nodeLevels.size(), false );
+    sameAsRoot[ 0 ] = true;
+    if( !solver.isUndefined( aggregateLiteral ) )
+    {
+        for( unsigned int k = 0; k < nodeLevels.size(); k++ )
+        {
+            int child = solver.isTrue( aggregateLiteral ) ? high[ k ] : low[ k ];
+            if( sameAsRoot[ k ] && child >= 0 )
+                sameAsRoot[ child ] = true;
+        }
+    }
+
+    Vector< Literal > nodeLiterals;
+    unsigned int auxVariables = 0;
+    for( unsigned int k = 0; k < nodeLevels.size(); k++ )
+    {
+        if( sameAsRoot[ k ] )
+        {
+            nodeLiterals.push_back( aggregateLiteral );
+            continue;
+        }
+        solver.addVariable();
+        solver.setFrozen( solver.numberOfVariables() );
+        nodeLiterals.push_back( Literal( solver.numberOfVariables(), POSITIVE ) );
+        auxVariables++;
+    }
+    statistics( &solver, onEncodingAggregate( auxVariables ) );
+
+    //Node = ite( lit, high, low ) with high >= low, since the constraint is monotone.
+    for( unsigned int k = 0; k < nodeLevels.size() && !solver.conflictDetected(); k++ )
+    {
+        Literal node = nodeLiterals[ k ];
+        Literal lit = solver.getLiteral( elements[ nodeLevels[ k ] ].second );
+        assert( high[ k ] != BDD_FALSE && low[ k ] != BDD_TRUE );
+        if( high[ k ] == BDD_TRUE )
+            addBddClause( lit.getOppositeLiteral(), node );
+        else
+        {
+            Literal h = nodeLiterals[ high[ k ] ];
+            addBddClause( lit.getOppositeLiteral(), h.getOppositeLiteral(), node );
+            addBddClause( h, node.getOppositeLiteral() );
+        }
+
+        if( low[ k ] == BDD_FALSE )
+            addBddClause( lit, node.getOppositeLiteral() );
+        else
+        {
+            Literal l = nodeLiterals[ low[ k ] ];
+            addBddClause( lit, l, node.getOppositeLiteral() );
+            addBddClause( l.getOppositeLiteral(), node );
+        }
+    }
+    return true;
+}
+
 void
 GringoNumericFormat::addWeightConstraints()
 {
@@ -2908,7 +3472,19 @@ GringoNumericFormat::addWeightConstraints()
         
         cleanWeightConstraint( weightConstraintRule );
         solver.notifyAggregate( weightConstraintRule );
+
+        if( weightConstraintToClauses( weightConstraintRule ) )
+            continue;
         
+        //The aggregate is true: no need of its literal.
+        if( solver.isTrue( weightConstraintRule->getId() ) )
+        {
+            PseudoBooleanConstraint* pb = weightConstraintToPseudoBooleanConstraint( weightConstraintRule );
+            solver.addPseudoBooleanConstraint( pb );
+            trace_msg( parser, 2, "Adding pseudo-Boolean constraint " << *pb );
+            continue;
+        }
+
         if( !wasp::Options::multiAggregates )
         {
             Aggregate* aggregate = weightConstraintToAggregate( weightConstraintRule );
@@ -25,6 +25,7 @@
 #include "Rule.h"
 #include "WeightConstraint.h"
 #include "AtomData.h"
+#include <map>
 #include <unordered_set>
 
 using namespace std;
@@ -40,20 +41,56 @@ public:
     * build the program.
     */
     void parse( istream& i );    
+
+    /**
+    * This function reads a program in the aspif format of gringo 5.
+    */
+    void parseAspif( istream& i );
     inline bool isHeadCycleFree( Component* component );    
     
 private:
     void parse( Istream& input );
+    void parseAspif( Istream& input );
+    void processProgram();
+    void runStage( const char* name, void ( GringoNumericFormat::*stage )() );
+    void checkProgramSize();
     inline void readChoiceRule( Istream& input );
     inline void readNormalRule( Istream& input );
-    inline void readNormalRule( Istream& input, unsigned head, unsigned bodySize, unsigned negativeSize );
     inline void readDisjunctiveRule( Istream& input );
-    inline void readConstraint( Istream& input );
     inline void readCount( Istream& input );
     inline void readSum( Istream& input );
     inline void readOptimizationRule( Istream& input );
-    inline void skipLiterals( Istream& input, unsigned howMany );
     inline void readBodySize( Istream& input, unsigned& bodySize, unsigned& negativeSize );
+    inline void readBody( Istream& input );
+    inline void readAtoms( Istream& input, unsigned howMany, Vector< unsigned >& atoms );
+    inline void readWeights( Istream& input, unsigned howMany, Vector< uint64_t >& weights );
+
+    void addNormalRule( unsigned head, const Vector< unsigned >& negativeBody, const Vector< unsigned >& positiveBody );
+    void addNormalRuleWithBody( unsigned head, const Vector< unsigned >& negativeBody, const Vector< unsigned >& positiveBody );
+    void addChoiceRule( const Vector< unsigned >& headAtoms, const Vector< unsigned >& negativeBody, const Vector< unsigned >& positiveBody );
+    void addDisjunctiveRule( const Vector< unsigned >& headAtoms, const Vector< unsigned >& negativeBody, const Vector< unsigned >& positiveBody );
+    void addConstraint( const Vector< unsigned >& negativeBody, const Vector< unsigned >& positiveBody );
+    void addCount( unsigned int id, uint64_t bound, const Vector< unsigned >& negativeLiterals, const Vector< unsigned >& positiveLiterals );
+    void addSum( unsigned int id, uint64_t bound, const Vector< unsigned >& negativeLiterals, const Vector< unsigned >& positiveLiterals, const Vector< uint64_t >& negativeWeights, const Vector< uint64_t >& positiveWeights );
+    void addOptimizationLiterals( WeightConstraint* rule, const Vector< unsigned >& negativeLiterals, const Vector< unsigned >& positiveLiterals, const Vector< uint64_t >& negativeWeights, const Vector< uint64_t >& positiveWeights );
+
+    /**
+     * Aspif statements. Aspif atoms are renumbered, since atom 1 is reserved
+     * and auxiliary atoms are needed for weight bodies and #show conditions.
+     */
+    void readAspifRule( Istream& input );
+    void readAspifMinimize( Istream& input, map< int, WeightConstraint* >& minimize );
+    void readAspifOutput( Istream& input );
+    void readAspifExternal( Istream& input );
+    void readAspifAssumption( Istream& input );
+    void readAspifHeuristic( Istream& input );
+    void readAspifBody( Istream& input );
+    void readAspifLiterals( Istream& input, unsigned howMany, Vector< unsigned >& negativeLiterals, Vector< unsigned >& positiveLiterals );
+    unsigned getAspifAtom( int lit );
+    unsigned createAuxAtom();
+    void skipLine( Istream& input );
+    void setAtomName( unsigned id, const char* name );
+    void addHeuristicDirectives();
     void addFact( unsigned head );
     void addTrueVariable( unsigned int id );
     void addFalseVariable( unsigned int id );
@@ -141,6 +178,9 @@ private:
     void atMostOneSequential( WeightConstraint* rule );
     void atMostOneBisequential( WeightConstraint* rule );
     Aggregate* weightConstraintToAggregate( WeightConstraint* rule );
+    PseudoBooleanConstraint* weightConstraintToPseudoBooleanConstraint( WeightConstraint* rule );
+    bool weightConstraintToClauses( WeightConstraint* rule );
+    void addBddClause( Literal lit1, Literal lit2, Literal lit3 = Literal::null );
     void addWeightConstraints();
     void cleanWeightConstraint( WeightConstraint* rule );
     void addOptimizationRules();
@@ -179,6 +219,25 @@ private:
     
     bool usedDictionary;
     unsigned int numberOfDisjunctiveRules;
+
+    Vector< unsigned > headAtomsBuffer;
+    Vector< unsigned > negativeBodyBuffer;
+    Vector< unsigned > positiveBodyBuffer;
+    Vector< uint64_t > negativeWeightsBuffer;
+    Vector< uint64_t > positiveWeightsBuffer;
+    string nameBuffer;
+
+    vector< unsigned > aspifAtoms;
+    struct HeuristicDirective
+    {
+        Var atom;
+        unsigned int modifier;
+        int bias;
+        unsigned int priority;
+        Vector< unsigned > negativeCondition;
+        Vector< unsigned > positiveCondition;
+    };
+    vector< HeuristicDirective* > heuristicDirectives;
 };
 
 GringoNumericFormat::GringoNumericFormat(
@@ -208,6 +267,12 @@ GringoNumericFormat::~GringoNumericFormat()
         delete weightConstraintRules.back();
         weightConstraintRules.pop_back();
     }
+    
+    while( !heuristicDirectives.empty() )
+    {
+        delete heuristicDirectives.back();
+        heuristicDirectives.pop_back();
+    }
 }
 
 void
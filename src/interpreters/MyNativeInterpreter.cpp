@@ -0,0 +1,129 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#include "MyNativeInterpreter.h"
+#include "WaspNativePlugin.h"
+#include "../util/WaspErrorMessage.h"
+
+#include <cstdio>
+#include <dlfcn.h>
+
+MyNativeInterpreter::MyNativeInterpreter(
+    char* filename,
+    string scriptDirectory ) : Interpreter(), library( NULL )
+{
+    string path( filename );
+    if( path.find( '/' ) == string::npos )
+        path = ( scriptDirectory != "" ? scriptDirectory : "." ) + "/" + path;
+    if( path.size() < 3 || path.compare( path.size() - 3, 3, ".so" ) != 0 )
+        path += ".so";
+
+    library = dlopen( path.c_str(), RTLD_NOW | RTLD_LOCAL );
+    if( library == NULL )
+    {
+        const char* error = dlerror();
+        string message = "Library " + path + " cannot be loaded";
+        if( error != NULL )
+            message += ": " + string( error );
+        WaspErrorMessage::errorGeneric( message + ".\n" );
+    }
+}
+
+MyNativeInterpreter::~MyNativeInterpreter()
+{
+    if( library != NULL )
+        dlclose( library );
+}
+
+void*
+MyNativeInterpreter::getMethod(
+    const string& method_name ) const
+{
+    unordered_map< string, void* >::const_iterator it = methods.find( method_name );
+    if( it != methods.end() )
+        return it->second;
+
+    void* method = library != NULL ? dlsym( library, method_name.c_str() ) : NULL;
+    methods[ method_name ] = method;
+    return method;
+}
+
+void
+MyNativeInterpreter::callListMethod(
+    const string& method_name,
+    const vector< int >& parameters,
+    vector< int >& output )
+{
+    WaspNativeMethod method = ( WaspNativeMethod ) getMethod( method_name );
+    if( method == NULL )
+    {
+        printf( "Method %s not found\n", method_name.c_str() );
+        return;
+    }
+
+    uint32_t size = 0;
+    const int32_t* result = method( parameters.empty() ? NULL : ( const int32_t* ) &parameters[ 0 ], parameters.size(), &size );
+    if( result == NULL )
+        return;
+    //The elements are read as the ones of the lists returned by the other interpreters.
+    for( uint32_t i = size; i > 0; i-- )
+        output.push_back( result[ i - 1 ] );
+}
+
+void
+MyNativeInterpreter::callListMethod(
+    const string& method_name,
+    const vector< int >& parameters,
+    vector< uint64_t >& output )
+{
+    WaspNativeWeightMethod method = ( WaspNativeWeightMethod ) getMethod( method_name );
+    if( method == NULL )
+    {
+        printf( "Method %s not found\n", method_name.c_str() );
+        return;
+    }
+
+    uint32_t size = 0;
+    const uint64_t* result = method( parameters.empty() ? NULL : ( const int32_t* ) &parameters[ 0 ], parameters.size(), &size );
+    if( result == NULL )
+        return;
+    for( uint32_t i = size; i > 0; i-- )
+        output.push_back( result[ i - 1 ] );
+}
+
+void
+MyNativeInterpreter::callVoidMethod(
+    const string& method_name,
+    int param1,
+    const string& param2 )
+{
+    WaspNativeStringMethod method = ( WaspNativeStringMethod ) getMethod( method_name );
+    if( method == NULL )
+    {
+        printf( "Method %s not found\n", method_name.c_str() );
+        return;
+    }
+    method( param1, param2.c_str() );
+}
+
+bool
+MyNativeInterpreter::checkMethod(
+    const string& method_name ) const
+{
+    return getMethod( method_name ) != NULL;
+}
@@ -0,0 +1,55 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#ifndef WASP_NATIVEINTERPRETER_H
+#define WASP_NATIVEINTERPRETER_H
+
+#include "Interpreter.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * Calls the functions of a shared library implementing the interface
+ * described in WaspNativePlugin.h.
+ * The library of the plugin "name" is scriptDirectory/name.so.
+ */
+class MyNativeInterpreter : public Interpreter
+{
+    public:
+        MyNativeInterpreter( char* filename, string scriptDirectory );
+        ~MyNativeInterpreter();
+
+        void callListMethod( const string& method_name, const vector< int >& parameters, vector< int >& output );
+        void callListMethod( const string& method_name, const vector< int >& parameters, vector< uint64_t >& output );
+        void callVoidMethod( const string& method_name, int param1, const string& param2 );
+        bool checkMethod( const string& method_name ) const;
+
+    private:
+        void* library;
+
+        /**
+         * The functions already resolved, NULL if the library does not export them.
+         */
+        mutable unordered_map< string, void* > methods;
+
+        void* getMethod( const string& method_name ) const;
+};
+
+#endif
@@ -54,145 +54,199 @@ MyPythonInterpreter::MyPythonInterpreter(
 
 MyPythonInterpreter::~MyPythonInterpreter()
 {
+    for( unordered_map< string, PyObject* >::iterator it = functions.begin(); it != functions.end(); ++it )
+        Py_XDECREF( it->second );
     if( callPyFinalize )
         Py_Finalize();
 }
 
-void
-MyPythonInterpreter::callListMethod(
-    const string& method_name,
-    const vector< int >& parameters,
-    vector< int >& output )
+PyObject*
+MyPythonInterpreter::getFunction(
+    const string& method_name ) const
 {
-    if( pModule == NULL )
-        return;
-    PyObject* pFunc = PyObject_GetAttrString( pModule, method_name.c_str() );
-    if( pFunc && PyCallable_Check( pFunc ) )
+    unordered_map< string, PyObject* >::const_iterator it = functions.find( method_name );
+    if( it != functions.end() )
+        return it->second;
+
+    PyObject* pFunc = pModule != NULL ? PyObject_GetAttrString( pModule, method_name.c_str() ) : NULL;
+    if( pFunc != NULL && !PyCallable_Check( pFunc ) )
     {
-        PyObject* pArgs = PyTuple_New( parameters.size() );
-        for( unsigned int i = 0; i < parameters.size(); i++ )
-        {
-            PyObject* pParam = Py_BuildValue( "i", parameters[ i ] );
-            PyTuple_SetItem( pArgs, i, pParam );
-        }
-        PyObject* result = PyObject_CallObject( pFunc, pArgs );
-        if( result )
-        {
-            bool isInt =
-            #ifdef PYTHON_THREE
-                PyLong_Check( result );
-            #else
-                PyInt_Check( result );
-            #endif
-            if( PyList_Check( result ) )
-            {
-                int size = PyList_Size( result );
-                for( int i = size - 1; i >= 0; i-- )
-                {
-                    PyObject* item = PyList_GetItem( result, i );
-                    bool isInt =
-                    #ifdef PYTHON_THREE
-                        PyLong_Check( item );
-                    #else
-                        PyInt_Check( item );
-                    #endif
-                    if( isInt )
-                    {
-                        int value =
-                        #ifdef PYTHON_THREE
-                            PyLong_AsLong( item );
-                        #else
-                            PyInt_AsLong( item );
-                        #endif
-                        output.push_back( value );
-                    }
-                }
-                Py_XDECREF( result );
-            }
-            else if( isInt )
-            {
-                int value =
-                #ifdef PYTHON_THREE
-                    PyLong_AsLong( result );
-                #else
-                    PyInt_AsLong( result );
-                #endif
-                output.push_back( value );
-            }
-            else if( PyErr_Occurred() )
-                PyErr_Print();
-        }
-        else if( PyErr_Occurred() )
-            PyErr_Print();
-        Py_XDECREF( pArgs );
+        Py_DECREF( pFunc );
+        pFunc = NULL;
     }
-    else
+    if( pFunc == NULL && PyErr_Occurred() )
+        PyErr_Clear();
+    functions[ method_name ] = pFunc;
+    return pFunc;
+}
+
+PyObject*
+MyPythonInterpreter::callFunction(
+    const string& method_name,
+    const vector< int >& parameters )
+{
+    PyObject* pFunc = getFunction( method_name );
+    if( pFunc == NULL )
     {
-        if( PyErr_Occurred() )
-            PyErr_Print();
         printf( "Method %s not found\n", method_name.c_str() );
+        return NULL;
     }
-    Py_XDECREF( pFunc );
+
+    PyObject* pArgs = PyTuple_New( parameters.size() );
+    for( unsigned int i = 0; i < parameters.size(); i++ )
+    {
+        PyObject* pParam =
+        #ifdef PYTHON_THREE
+            PyLong_FromLong( parameters[ i ] );
+        #else
+            PyInt_FromLong( parameters[ i ] );
+        #endif
+        PyTuple_SET_ITEM( pArgs, i, pParam );
+    }
+    PyObject* result = PyObject_CallObject( pFunc, pArgs );
+    Py_DECREF( pArgs );
+    if( result == NULL && PyErr_Occurred() )
+        PyErr_Print();
+    return result;
 }
 
-void MyPythonInterpreter::callListMethod(
-    const string& method_name,
-    const vector< int >& parameters,
-    vector< uint64_t >& output )
+static bool
+isInteger(
+    PyObject* item )
 {
-    if( pModule == NULL )
-        return;
-    PyObject* pFunc = PyObject_GetAttrString( pModule,method_name.c_str() );
-    if( pFunc && PyCallable_Check( pFunc ) )
+    #ifdef PYTHON_THREE
+    return PyLong_Check( item );
+    #else
+    return PyInt_Check( item ) || PyLong_Check( item );
+    #endif
+}
+
+static void
+readInteger(
+    PyObject* item,
+    int& value )
+{
+    #ifdef PYTHON_THREE
+    value = PyLong_AsLong( item );
+    #else
+    value = PyInt_AsLong( item );
+    #endif
+}
+
+static void
+readInteger(
+    PyObject* item,
+    uint64_t& value )
+{
+    #ifdef PYTHON_THREE
+    value = PyLong_AsUnsignedLongLongMask( item );
+    #else
+    value = PyInt_AsUnsignedLongLongMask( item );
+    #endif
+}
+
+/**
+ * Reads the elements of a buffer of integers, e.g. an array or a numpy array.
+ * @return false if the elements of the buffer are not integers
+ */
+template< class T >
+static bool
+readBuffer(
+    PyObject* result,
+    vector< T >& output )
+{
+    Py_buffer view;
+    if( PyObject_GetBuffer( result, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS ) != 0 )
     {
-        PyObject* pArgs = PyTuple_New( parameters.size() );
-        for( unsigned int i = 0; i < parameters.size(); i++ )
-        {
-            PyObject* pParam = Py_BuildValue( "i", parameters[ i ] );
-            PyTuple_SetItem( pArgs, i, pParam );
-        }
-        PyObject* result = PyObject_CallObject( pFunc, pArgs );
-        if( result )
+        PyErr_Clear();
+        return false;
+    }
+
+    //The format may start with a byte order character.
+    char format = view.format != NULL ? view.format[ strlen( view.format ) - 1 ] : 'B';
+    bool isSigned = strchr( "bhilq", format ) != NULL;
+    bool ok = isSigned || strchr( "BHILQ", format ) != NULL;
+    if( ok )
+    {
+        Py_ssize_t size = view.len / view.itemsize;
+        const char* buffer = ( const char* ) view.buf;
+        for( Py_ssize_t i = size - 1; i >= 0; i-- )
         {
-            bool isInt = PyLong_Check( result );
-            if( PyList_Check( result ) )
+            const char* item = buffer + i * view.itemsize;
+            int64_t value;
+            switch( view.itemsize )
             {
-                int size = PyList_Size( result );
-                for( int i = size - 1; i >= 0; i-- )
-                {
-                    PyObject* item = PyList_GetItem( result, i );
-                    if( PyLong_Check( item ) )
-                    {
-                        uint64_t value = PyLong_AsUnsignedLongLongMask( item );
-                        output.push_back( value );
-                    }
-                }
-                Py_XDECREF( result );
+                case 1: value = isSigned ? ( int64_t ) *( const int8_t* ) item : ( int64_t ) *( const uint8_t* ) item; break;
+                case 2: value = isSigned ? ( int64_t ) *( const int16_t* ) item : ( int64_t ) *( const uint16_t* ) item; break;
+                case 4: value = isSigned ? ( int64_t ) *( const int32_t* ) item : ( int64_t ) *( const uint32_t* ) item; break;
+                default: value = *( const int64_t* ) item; break;
             }
-            else if( isInt )
+            output.push_back( ( T ) value );
+        }
+    }
+    PyBuffer_Release( &view );
+    return ok;
+}
+
+/**
+ * The elements of lists and buffers are added in reverse order.
+ */
+template< class T >
+static void
+readResult(
+    PyObject* result,
+    vector< T >& output )
+{
+    if( PyList_Check( result ) )
+    {
+        int size = PyList_Size( result );
+        for( int i = size - 1; i >= 0; i-- )
+        {
+            PyObject* item = PyList_GetItem( result, i );
+            if( isInteger( item ) )
             {
-                uint64_t value =
-                #ifdef PYTHON_THREE
-                    PyLong_AsUnsignedLongLongMask( result );
-                #else
-                    PyInt_AsUnsignedLongLongMask( result );
-                #endif
+                T value;
+                readInteger( item, value );
                 output.push_back( value );
             }
-            else if( PyErr_Occurred() )
-                PyErr_Print();
         }
-        else if( PyErr_Occurred() )
-            PyErr_Print();
-        Py_XDECREF( pArgs );
     }
-    else
+    else if( isInteger( result ) )
     {
-        if( PyErr_Occurred() )
-            PyErr_Print();
-        printf("Method %s not found\n", method_name.c_str());
+        T value;
+        readInteger( result, value );
+        output.push_back( value );
     }
-    Py_XDECREF( pFunc );
+    else if( PyObject_CheckBuffer( result ) )
+        readBuffer( result, output );
+    if( PyErr_Occurred() )
+        PyErr_Print();
+}
+
+void
+MyPythonInterpreter::callListMethod(
+    const string& method_name,
+    const vector< int >& parameters,
+    vector< int >& output )
+{
+    PyObject* result = callFunction( method_name, parameters );
+    if( result == NULL )
+        return;
+    readResult( result, output );
+    Py_DECREF( result );
+}
+
+void
+MyPythonInterpreter::callListMethod(
+    const string& method_name,
+    const vector< int >& parameters,
+    vector< uint64_t >& output )
+{
+    PyObject* result = callFunction( method_name, parameters );
+    if( result == NULL )
+        return;
+    readResult( result, output );
+    Py_DECREF( result );
 }
 
 void MyPythonInterpreter::callVoidMethod(
@@ -200,10 +254,8 @@ void MyPythonInterpreter::callVoidMethod(
     int param1,
     const string& param2 )
 {
-    if( pModule == NULL )
-        return;
-    PyObject* pFunc = PyObject_GetAttrString( pModule, method_name.c_str() );
-    if( pFunc && PyCallable_Check( pFunc ) )
+    PyObject* pFunc = getFunction( method_name );
+    if( pFunc )
     {
         PyObject* pArgs = PyTuple_New( 2 );
         PyObject* param1_python =
@@ -230,28 +282,13 @@ void MyPythonInterpreter::callVoidMethod(
         Py_XDECREF( pArgs );
     }
     else
-    {
-        if( PyErr_Occurred() )
-            PyErr_Print();
         printf( "Method %s not found\n", method_name.c_str() );
-    }
-    Py_XDECREF( pFunc );
 }
 
 bool MyPythonInterpreter::checkMethod(
     const string& method_name ) const
 {
-    bool res = false;
-    if( pModule == NULL )
-        return res;
-    PyObject* pFunc = PyObject_GetAttrString( pModule, method_name.c_str() );
-    if( pFunc && PyCallable_Check( pFunc ) )
-       res = true;
-    else if( PyErr_Occurred() )
-        PyErr_Clear();
-
-    Py_XDECREF( pFunc );
-    return res;
+    return getFunction( method_name ) != NULL;
 }
 
 void MyPythonInterpreter::addElementInMap(
@@ -21,6 +21,7 @@
 
 #include "Interpreter.h"
 #include <string>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
@@ -44,6 +45,19 @@ class MyPythonInterpreter : public Interpreter
     private:        
         PyObject* pModule;
         bool callPyFinalize;
+
+        /**
+         * The functions of the module, resolved at the first call.
+         * NULL if the module does not define them.
+         */
+        mutable unordered_map< string, PyObject* > functions;
+
+        PyObject* getFunction( const string& method_name ) const;
+
+        /**
+         * @return the result of the function (new reference), NULL if it fails
+         */
+        PyObject* callFunction( const string& method_name, const vector< int >& parameters );
 };
 
 #else
@@ -0,0 +1,52 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#ifndef WASP_NATIVEPLUGIN_H
+#define WASP_NATIVEPLUGIN_H
+
+/*
+ * C interface of the plugins loaded with --interpreter=native.
+ * A plugin is a shared library exporting, with C linkage, a function for each
+ * method it implements. The names of the functions are the names of the
+ * methods of python plugins (onLiteralTrue, checkAnswerSet, ...).
+ *
+ * The parameters are passed as an array of integers. The output is an array
+ * owned by the plugin, which must be valid until the next call of the plugin:
+ * it has the same meaning of the list (or of the integer, if outputSize is 1)
+ * returned by python plugins. Functions without output may return NULL.
+ *
+ * The methods receiving a name (addedVarName and setScriptDirectory) use
+ * WaspNativeStringMethod, while addWeightsForWeakConstraints uses
+ * WaspNativeWeightMethod.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef const int32_t* ( *WaspNativeMethod )( const int32_t* parameters, uint32_t size, uint32_t* outputSize );
+typedef const uint64_t* ( *WaspNativeWeightMethod )( const int32_t* parameters, uint32_t size, uint32_t* outputSize );
+typedef void ( *WaspNativeStringMethod )( int32_t param1, const char* param2 );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
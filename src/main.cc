@@ -51,8 +51,10 @@ int main( int argc, char** argv )
     signal( SIGTERM, my_handler );
     signal( SIGXCPU, my_handler );
     
-    waspFacade.readInput( cin );
-    if( wasp::Options::predMinimizationAlgorithm != NO_PREDMINIMIZATION ) { PredicateMinimization p( waspFacade ); p.solve(); }
+    if( !wasp::Options::loadSnapshot.empty() ) waspFacade.loadSnapshot( wasp::Options::loadSnapshot );
+    else waspFacade.readInput( cin );
+    if( !wasp::Options::dumpSnapshot.empty() ) waspFacade.dumpSnapshot( wasp::Options::dumpSnapshot );
+    else if( wasp::Options::predMinimizationAlgorithm != NO_PREDMINIMIZATION ) { PredicateMinimization p( waspFacade ); p.solve(); }
     else if( wasp::Options::queryAlgorithm == ONE_QUERIES 
             || wasp::Options::queryAlgorithm == KDYN_QUERIES 
             || wasp::Options::queryAlgorithm == PREFERENCE_QUERIES
@@ -52,6 +52,7 @@ Aggregate::reset(
         if( trail.empty() )
         {
             trace_msg( aggregates, 3, "Restored counters. Values: " << counterW1 << " - " << counterW2 );
+            assert( counterW1 == levelZeroCounterW1 && counterW2 == levelZeroCounterW2 );
             return;
         }
         
@@ -81,10 +82,36 @@ Aggregate::onLiteralFalse(
     
     unsigned int index = ( position > 0 ? position : -position ); 
     int64_t& counter = ( position > 0 ? counterW2 : counterW1 );
+    int64_t& unattachedWeight = ( position > 0 ? unattachedWeightW2 : unattachedWeightW1 );
+    int64_t required = ( index == 1 ? maxWeight : requiredSlack() );
 
-    trace_msg( aggregates, 2, "Updating counter. Old value: " << counter << " - New value: " << counter - weights[ index ] );
+    if( attachWatches( solver, ac, required + weights[ index ] ) )
+    {
+        if( index != 1 && solver.getDecisionLevel( currentLiteral ) != 0 )
+        {
+            trace_msg( aggregates, 2, "Enough weight is still watched: removing the watch of " << currentLiteral );
+            ( ac == POS ? attachedW1 : attachedW2 )[ index ] = false;
+            ( ac == POS ? unattachedW1 : unattachedW2 ).push_back( index );
+            unattachedWeight += weights[ index ];
+            solver.detachCurrentPropagator();
+            return false;
+        }
+
+        trace_msg( aggregates, 2, "Updating counter. Old value: " << counter << " - New value: " << counter - weights[ index ] );
+        counter -= weights[ index ];
+        watched[ index ] = false;
+        if( solver.getDecisionLevel( currentLiteral ) != 0 )
+            trail.push_back( position );
+        else
+            ( position > 0 ? levelZeroCounterW2 : levelZeroCounterW1 ) -= weights[ index ];
+        return true;
+    }
+
+    //All literals that are not watched are false.
+    int64_t slack = counter - unattachedWeight;
+    trace_msg( aggregates, 2, "Updating counter. Old value: " << counter << " - New value: " << counter - weights[ index ] << " - Slack: " << slack - weights[ index ] );
     
-    if( counter < ( int64_t ) weights[ index ] )
+    if( slack < ( int64_t ) weights[ index ] )
     {
         assert_msg( solver.getDecisionLevel( currentLiteral ) == 0, "Literal " << currentLiteral << " in " << *this << " has a decision level " << solver.getDecisionLevel( currentLiteral ) );
         trace_msg( aggregates, 3, "A conflict happened." );        
@@ -97,16 +124,30 @@ Aggregate::onLiteralFalse(
     
     if( solver.getDecisionLevel( currentLiteral ) != 0 )
         trail.push_back( position );
+    else
+        ( position > 0 ? levelZeroCounterW2 : levelZeroCounterW1 ) -= weights[ index ];
+
+    inferLiterals( solver, ac, slack - weights[ index ], currentLiteral );
+    return true;
+}
 
+void
+Aggregate::inferLiterals(
+    Solver& solver,
+    int ac,
+    int64_t slack,
+    Literal currentLiteral )
+{
+    const vector< bool >& attached = ( ac == POS ? attachedW1 : attachedW2 );
     trace_msg( aggregates, 2, "Umax: " << umax << " - size: " << size() );
-    while( umax < literals.size() && ( int64_t ) weights[ umax ] > counter )
+    while( umax < literals.size() && ( int64_t ) weights[ umax ] > slack )
     {
-        if( watched[ umax ] )
+        if( watched[ umax ] && attached[ umax ] )
         {
             if( literalOfUnroll == Literal::null )
                 literalOfUnroll = currentLiteral;
             active = ac;
-            Literal lit = ( ac == POS ? literals[ umax ].getOppositeLiteral() : literals[ umax ] );
+            Literal lit = sideLiteral( ac, umax );
             if( !solver.isTrue( lit ) )
             {                
                 //Maybe we don't need to add the position of this literal
@@ -116,7 +157,7 @@ Aggregate::onLiteralFalse(
 //                createClauseFromTrail( lit );
                 solver.assignLiteral( lit, this );
                 if( solver.conflictDetected() )
-                    return true;
+                    return;
             }
             else
             {
@@ -127,8 +168,156 @@ Aggregate::onLiteralFalse(
         ++umax;
         trace_msg( aggregates, 3, "Updated umax. New Value: " << umax );        
     }
-    
-    return true;
+}
+
+void
+Aggregate::attach(
+    Solver& solver )
+{
+    Literal aggregateLiteral = literals[ 1 ].getOppositeLiteral();
+    solver.addPropagator( aggregateLiteral, this, PropagatorData( -1 ) );
+    solver.addPropagator( literals[ 1 ], this, PropagatorData( 1 ) );
+    if( !solver.isTrue( aggregateLiteral ) )
+        attachSide( solver, POS );
+    if( !solver.isFalse( aggregateLiteral ) )
+        attachSide( solver, NEG );
+}
+
+void
+Aggregate::attachSide(
+    Solver& solver,
+    int ac )
+{
+    int64_t counter = ( ac == POS ? counterW1 : counterW2 );
+    int64_t& unattachedWeight = ( ac == POS ? unattachedWeightW1 : unattachedWeightW2 );
+    vector< bool >& attached = ( ac == POS ? attachedW1 : attachedW2 );
+    Vector< unsigned int >& unattached = ( ac == POS ? unattachedW1 : unattachedW2 );
+    assert( unattached.empty() && unattachedWeight == 0 );
+
+    //Lightest literals first: the heaviest ones are watched.
+    int64_t required = requiredSlack();
+    for( unsigned int j = literals.size() - 1; j >= 2; j-- )
+    {
+        if( !solver.isUndefined( literals[ j ] ) || counter - unattachedWeight - ( int64_t ) weights[ j ] < required )
+            continue;
+        attached[ j ] = false;
+        unattached.push_back( j );
+        unattachedWeight += weights[ j ];
+    }
+    trace_msg( aggregates, 2, "Watching " << ( size() - 1 - unattached.size() ) << " literals out of " << ( size() - 1 ) << " for side " << ac );
+
+    for( unsigned int j = 2; j < literals.size(); j++ )
+        if( attached[ j ] )
+            solver.addPropagator( sideLiteral( ac, j ), this, PropagatorData( -ac * ( int ) j ) );
+}
+
+bool
+Aggregate::attachWatches(
+    Solver& solver,
+    int ac,
+    int64_t slack )
+{
+    int64_t counter = ( ac == POS ? counterW1 : counterW2 );
+    int64_t& unattachedWeight = ( ac == POS ? unattachedWeightW1 : unattachedWeightW2 );
+    if( counter - unattachedWeight >= slack )
+        return true;
+
+    vector< bool >& attached = ( ac == POS ? attachedW1 : attachedW2 );
+    Vector< unsigned int >& unattached = ( ac == POS ? unattachedW1 : unattachedW2 );
+    unsigned int i = 0;
+    while( i < unattached.size() )
+    {
+        unsigned int j = unattached[ i ];
+        Literal lit = sideLiteral( ac, j );
+        if( solver.isFalse( lit ) )
+        {
+            ++i;
+            continue;
+        }
+
+        trace_msg( aggregates, 3, "Watching " << lit );
+        solver.addPropagator( lit, this, PropagatorData( -ac * ( int ) j ) );
+        attached[ j ] = true;
+        unattachedWeight -= weights[ j ];
+        unattached[ i ] = unattached.back();
+        unattached.pop_back();
+        if( counter - unattachedWeight >= slack )
+            return true;
+    }
+    return false;
+}
+
+void
+Aggregate::checkWatches(
+    Solver& solver,
+    int ac )
+{
+    Literal aggrLiteral = sideLiteral( ac, 1 );
+    if( solver.conflictDetected() || solver.isTrue( aggrLiteral ) || active + ac == 0 || attachWatches( solver, ac, requiredSlack() ) )
+        return;
+
+    int64_t slack = ( ac == POS ? counterW1 - unattachedWeightW1 : counterW2 - unattachedWeightW2 );
+    trace_msg( aggregates, 2, "Not enough weight is watched. Slack: " << slack );
+    if( slack < 0 )
+    {
+        assert( solver.isFalse( aggrLiteral ) );
+        solver.assignLiteral( aggrLiteral, this );
+        return;
+    }
+    inferLiterals( solver, ac, slack, aggrLiteral );
+}
+
+void
+Aggregate::computeExplanation(
+    const Solver& solver,
+    Literal lit )
+{
+    //A side literal is inferred when the weight of the false side literals is
+    //greater than the initial counter of the side minus its weight.
+    explanation.clear();
+    if( active == 0 )
+        return;
+
+    //A literal inferred by the aggregate depends only on the literals false before it.
+    //If the inferred literal is false the aggregate is violated.
+    unsigned int boundary = MAXUNSIGNEDINT;
+    uint64_t weightOfInferred = 0;
+    for( unsigned int i = 0; i < trail.size(); i++ )
+    {
+        //The inferred literals are stored with the sign of the side, the false
+        //literals with the opposite sign.
+        int position = trail[ i ];
+        unsigned int index = abs( position );
+        Literal l = sideLiteral( active, index );
+        if( watched[ index ] )
+        {
+            if( l.getVariable() != lit.getVariable() )
+                continue;
+            weightOfInferred = weights[ index ];
+            if( solver.isTrue( l ) )
+                boundary = solver.getPositionInTrail( l.getVariable() );
+            break;
+        }
+        if( ( position < 0 ? POS : NEG ) == active && solver.isFalse( l ) )
+            explanation.addCandidate( l, weights[ index ], solver.getDecisionLevel( l ) );
+    }
+
+    int64_t counter = ( active == POS ? levelZeroCounterW1 : levelZeroCounterW2 );
+    const Vector< unsigned int >& unattached = ( active == POS ? unattachedW1 : unattachedW2 );
+    for( unsigned int k = 0; k < unattached.size(); k++ )
+    {
+        Literal l = sideLiteral( active, unattached[ k ] );
+        if( !solver.isFalse( l ) )
+            continue;
+        unsigned int level = solver.getDecisionLevel( l );
+        if( level == 0 )
+            counter -= weights[ unattached[ k ] ];
+        else if( solver.getPositionInTrail( l.getVariable() ) < boundary )
+            explanation.addCandidate( l, weights[ unattached[ k ] ], level );
+    }
+
+    if( weightOfInferred > 0 )
+        explanation.reduce( counter - ( int64_t ) weightOfInferred + 1 );
 }
 
 #ifndef NDEBUG
@@ -160,11 +349,21 @@ Aggregate::updateBound(
     uint64_t bound )
 {
     trace_msg( aggregates, 1, "Updating bound. New value: " << bound );
+    this->bound = bound;
     uint64_t sumOfWeights = 0;    
+    maxWeight = 0;
+    unattachedWeightW1 = 0;
+    unattachedWeightW2 = 0;
     for( unsigned int i = 2; i < weights.size(); i++ )
     {
         if( weights[ i ] > bound )
             weights[ i ] = bound;
+        if( weights[ i ] > maxWeight )
+            maxWeight = weights[ i ];
+        if( !attachedW1[ i ] )
+            unattachedWeightW1 += weights[ i ];
+        if( !attachedW2[ i ] )
+            unattachedWeightW2 += weights[ i ];
 
         // if( !literals[ i ].isFalse() || literals[ i ].getDecisionLevel() != 0 ) 
         sumOfWeights += weights[ i ]; 
@@ -176,6 +375,8 @@ Aggregate::updateBound(
 
     counterW1 = sumOfWeights - w1 + w;
     counterW2 = sumOfWeights - bound + w;
+    levelZeroCounterW1 = counterW1;
+    levelZeroCounterW2 = counterW2;
 
     trace_msg( aggregates, 1, "Counters: " << counterW1 << "," << counterW2 );
     weights[ 1 ] = w;
@@ -186,15 +387,23 @@ Aggregate::updateBound(
             continue;                        
         if( solver.isTrue( literals[ i ] ) )
         {
-            this->onLiteralFalse( solver, literals[ i ].getOppositeLiteral(), -i );
+            if( attachedW1[ i ] )
+                this->onLiteralFalse( solver, literals[ i ].getOppositeLiteral(), -i );
 //            counterW1 -= weights[ i ];
         }
         else if( solver.isFalse( literals[ i ] ) )
         {
-            this->onLiteralFalse( solver, literals[ i ], i );
+            if( attachedW2[ i ] )
+                this->onLiteralFalse( solver, literals[ i ], i );
 //            counterW2 -= weights[ i ];
         }
     }
+
+    //With the new bound the watched literals could be not enough.
+    if( !unattachedW1.empty() )
+        checkWatches( solver, POS );
+    if( !unattachedW2.empty() )
+        checkWatches( solver, NEG );
     trace_msg( aggregates, 1, "Counters final: " << counterW1 << "," << counterW2 );
     return ( sumOfWeights >= bound );
 }
@@ -264,37 +473,13 @@ Aggregate::print( ostream& out ) const
 
 void
 Aggregate::onLearning(
-    const Solver&,
+    const Solver& solver,
     Learning* strategy,
     Literal lit )
 {
-//    for( int i = trail.size() - 1; i >= 0; i-- )
-    for( unsigned int i = 0; i < trail.size(); i++ )
-    {
-        int position = trail[ i ];
-        
-        int ac = ( position < 0 ? POS : NEG );
-        
-        unsigned int index = ( position > 0 ? position : -position );
-        Literal l = literals[ index ];    
-        if( ac == active )
-        {
-            if( active == NEG )
-                l = l.getOppositeLiteral();
-
-            if( !watched[ index ] )
-            {
-//                assert_msg( solver.getDecisionLevel( l ) > 0, "Literal " << l << " has been inferred at the decision level 0" );
-//                clause->addLiteral( l.getOppositeLiteral() );   
-                strategy->onNavigatingLiteral( l.getOppositeLiteral() );                
-            }
-            
-            assert( l != lit );            
-        }
-        
-        if( l.getVariable() == lit.getVariable() )
-            break;        
-    }
+    computeExplanation( solver, lit );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        strategy->onNavigatingLiteral( explanation[ i ] );
 }
 
 void
@@ -304,68 +489,20 @@ Aggregate::onNavigatingForUnsatCore(
     unsigned int numberOfCalls,
     Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
-    {
-        int position = trail[ i ];
-        
-        int ac = ( position < 0 ? POS : NEG );
-        
-        unsigned int index = ( position > 0 ? position : -position );
-        Literal l = literals[ index ];    
-        if( ac == active )
-        {
-            if( active == NEG )
-                l = l.getOppositeLiteral();
-            
-            if( !watched[ index ] )
-            {
-//                assert_msg( solver.getDecisionLevel( l ) > 0, "Literal " << l << " has been inferred at the decision level 0" );
-//                clause->addLiteral( l.getOppositeLiteral() );                
-//                toVisit.push_back( l ); //l.getOppositeLiteral() );
-                Var variable = l.getVariable();
-                if( solver.getDecisionLevel( variable ) > 0 )
-                    visited[ variable ] = numberOfCalls;                
-            }
-            
-            assert( l != lit );            
-        }
-        
-        if( l.getVariable() == lit.getVariable() )
-            break;        
-    }
+    computeExplanation( solver, lit );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        visited[ explanation[ i ].getVariable() ] = numberOfCalls;
 }
 
 bool
 Aggregate::onNavigatingLiteralForAllMarked(
-    const Solver&,
+    const Solver& solver,
     Learning* strategy,
     Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
-    {
-        int position = trail[ i ];        
-        int ac = ( position < 0 ? POS : NEG );
-        
-        unsigned int index = ( position > 0 ? position : -position );
-        Literal l = literals[ index ];            
-        if( ac == active )
-        {
-            if( active == NEG )
-                l = l.getOppositeLiteral();
-        
-            if( !watched[ index ] )
-            {
-//                assert_msg( l.getDecisionLevel() > 0, "Literal " << l << " has been inferred at the decision level 0" );
-                if( !strategy->onNavigatingLiteralForAllMarked( l.getOppositeLiteral() ) )
-                    return false;
-            }
-            
-            assert( l != lit );            
-        }
-        
-        if( l.getVariable() == lit.getVariable() )
-            break;
-    }
-    
+    computeExplanation( solver, lit );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        if( !strategy->onNavigatingLiteralForAllMarked( explanation[ i ] ) )
+            return false;
     return true;
-}
\ No newline at end of file
+}
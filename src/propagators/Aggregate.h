@@ -23,6 +23,7 @@
 #include <iostream>
 
 #include "Propagator.h"
+#include "WeightedExplanation.h"
 #include "../Clause.h"
 #include "../Learning.h"
 #include "../Literal.h"
@@ -49,13 +50,23 @@ class Aggregate : public Propagator, public Reason
         
         inline unsigned int size() const { return literals.size() - 1; }
 
-        inline void addLiteral( Literal lit, uint64_t weight ) { literals.push_back( lit ); weights.push_back( weight ); watched.push_back( true ); }        
+        inline void addLiteral( Literal lit, uint64_t weight ) { literals.push_back( lit ); weights.push_back( weight ); watched.push_back( true ); attachedW1.push_back( true ); attachedW2.push_back( true ); }        
         
         inline Literal getLiteral( unsigned int i ) const { assert( i < literals.size() ); return literals[ i ]; }
         inline uint64_t getWeight( unsigned int i ) const { assert( i < weights.size() ); return weights[ i ]; }
         
         unsigned int getLevelOfBackjump( const Solver& solver, uint64_t bound );
         bool updateBound( Solver& solver, uint64_t bound );
+
+        /**
+         * Registers the aggregate in the solver. Each side of the aggregate
+         * watches only the heaviest literals needed to cover the bound plus the
+         * maximum weight: the others are watched when a watched literal is
+         * falsified and no longer enough weight is watched.
+         * Must be called after updateBound.
+         */
+        void attach( Solver& solver );
+        inline uint64_t getBound() const { return bound; }
         inline bool isTrue() const;        
         
         inline Literal operator[]( unsigned int idx ) const { assert_msg( ( idx > 0 && idx < literals.size() ), "Index is " << idx << " - literals: " << literals.size() ); return literals[ idx ]; }
@@ -80,16 +91,46 @@ class Aggregate : public Propagator, public Reason
         vector< Literal > literals;
         vector< uint64_t > weights;
         vector< bool > watched;
+
+        vector< bool > attachedW1;
+        vector< bool > attachedW2;
+        Vector< unsigned int > unattachedW1;
+        Vector< unsigned int > unattachedW2;
+        int64_t unattachedWeightW1;
+        int64_t unattachedWeightW2;
+        uint64_t maxWeight;
         
         int active;
         
         int64_t counterW1;
         int64_t counterW2;
+
+        /**
+         * The counters updated only with the literals false at level 0.
+         */
+        int64_t levelZeroCounterW1;
+        int64_t levelZeroCounterW2;
         
         unsigned int umax;
+        uint64_t bound;
         Vector< int > trail;
         
         Literal literalOfUnroll;
+        WeightedExplanation explanation;
+
+        inline Literal sideLiteral( int ac, unsigned int i ) const { return ac == POS ? literals[ i ].getOppositeLiteral() : literals[ i ]; }
+        inline int64_t requiredSlack() const { return watched[ 1 ] ? weights[ 1 ] : maxWeight; }
+
+        void attachSide( Solver& solver, int ac );
+        bool attachWatches( Solver& solver, int ac, int64_t slack );
+        void checkWatches( Solver& solver, int ac );
+        void inferLiterals( Solver& solver, int ac, int64_t slack, Literal lit );
+
+        /**
+         * Computes in explanation the heaviest false literals, assigned before
+         * the inferred literal, whose weight is enough to infer it.
+         */
+        void computeExplanation( const Solver& solver, Literal lit );
 
 //        void createClauseFromTrail( Literal lit );
         #ifndef NDEBUG
@@ -142,11 +183,13 @@ class Aggregate : public Propagator, public Reason
         }
 };
 
-Aggregate::Aggregate() : Propagator(), active( 0 ), counterW1( 0 ), counterW2( 0 ), umax( 1 ), literalOfUnroll( Literal::null )
+Aggregate::Aggregate() : Propagator(), unattachedWeightW1( 0 ), unattachedWeightW2( 0 ), maxWeight( 0 ), active( 0 ), counterW1( 0 ), counterW2( 0 ), levelZeroCounterW1( 0 ), levelZeroCounterW2( 0 ), umax( 1 ), bound( 0 ), literalOfUnroll( Literal::null )
 {
     literals.push_back( Literal::null );
     weights.push_back( 0 );    
     watched.push_back( false );
+    attachedW1.push_back( false );
+    attachedW2.push_back( false );
 }
 
 bool
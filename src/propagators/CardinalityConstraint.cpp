@@ -24,54 +24,72 @@
 
 void
 CardinalityConstraint::reset(
-    const Solver& solver )
-{    
-    trace_msg( aggregates, 2, "Calling reset for cardinality constraint " << *this );         
-    while( true )
-    {
-        if( trail.empty() )
-            break;
-        
-        unsigned int pos = trail.back();
-        if( !solver.isUndefined( at( pos ) ) )
-            break;
-
-        inTrail[ pos ] = false;        
-        trail.pop_back();
-        maxFalse++;
-    }
+    const Solver& )
+{
 }
 
 bool
 CardinalityConstraint::onLiteralFalse(
     Solver& solver,
-    Literal,
+    Literal currentLiteral,
     PropagatorData p )
 {
     int pos = p.position();
-    assert( pos > 0 );
-    trace_msg( aggregates, 10, "CardinalityConstraint: " << *this << ". Literal " << literals[ pos ] << "is false" ); 
-    assert_msg( maxFalse > 0, *this );
-    trail.push_back( pos );
-    assert( !inTrail[ pos ] );
-    inTrail[ pos ] = true;
-    
-    if( --maxFalse > 0 )
-        return true;
-    
-    for( unsigned int i = 0; i < literals.size(); i++ )
+    unsigned int watches = numberOfWatches();
+    assert( pos >= 0 && ( unsigned int ) pos < watches );
+    assert( literals[ pos ] == currentLiteral );
+    trace_msg( aggregates, 10, "CardinalityConstraint: " << *this << ". Literal " << currentLiteral << " is false" ); 
+
+    for( unsigned int i = watches; i < literals.size(); i++ )
+    {
+        if( solver.isFalse( literals[ i ] ) )
+            continue;
+
+        trace_msg( aggregates, 10, "Moving the watch to " << literals[ i ] );
+        literals[ pos ] = literals[ i ];
+        literals[ i ] = currentLiteral;
+        solver.addPropagator( literals[ pos ], this, PropagatorData( pos ) );
+        solver.detachCurrentPropagator();
+        return false;
+    }
+
+    if( watches <= bound )
+    {
+        trace_msg( aggregates, 10, "All literals must be true: conflict" );
+        solver.assignLiteral( currentLiteral, this );
+        return false;
+    }
+
+    for( unsigned int i = 0; i < watches; i++ )
     {
         Literal lit = literals[ i ];
-        if( solver.isTrue( lit ) || inTrail[ i ] )
+        if( i == ( unsigned int ) pos || solver.isTrue( lit ) )
             continue;
         
         solver.assignLiteral( lit, this );
         
         if( solver.conflictDetected() )
-            return true;
-        
+            break;
     }    
-    return true;
+    return false;
+}
+
+void
+CardinalityConstraint::attach(
+    Solver& solver )
+{
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        if( solver.isFalse( literals[ i ] ) )
+            continue;
+        Literal tmp = literals[ j ];
+        literals[ j++ ] = literals[ i ];
+        literals[ i ] = tmp;
+    }
+
+    for( unsigned int i = 0; i < numberOfWatches(); i++ )
+        solver.addPropagator( literals[ i ], this, PropagatorData( i ) );
 }
 
 ostream&
@@ -104,11 +122,14 @@ void
 CardinalityConstraint::onLearning(
     const Solver& solver,
     Learning* strategy,
-    Literal )
+    Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
-        if( solver.getDecisionLevel( at( trail[ i ] ) ) > 0 )
-            strategy->onNavigatingLiteral( at( trail[ i ] ) );
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        Literal l = literals[ i ];
+        if( solver.isFalse( l ) && l.getVariable() != lit.getVariable() && solver.getDecisionLevel( l ) > 0 )
+            strategy->onNavigatingLiteral( l );
+    }
 }
 
 void
@@ -116,22 +137,28 @@ CardinalityConstraint::onNavigatingForUnsatCore(
     const Solver& solver,
     vector< unsigned int >& visited,
     unsigned int numberOfCalls,
-    Literal )
+    Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
-        if( solver.getDecisionLevel( at( trail[ i ] ) ) > 0 )
-            visited[ at( trail[ i ] ).getVariable() ] = numberOfCalls;    
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        Literal l = literals[ i ];
+        if( solver.isFalse( l ) && l.getVariable() != lit.getVariable() && solver.getDecisionLevel( l ) > 0 )
+            visited[ l.getVariable() ] = numberOfCalls;
+    }
 }
 
 bool
 CardinalityConstraint::onNavigatingLiteralForAllMarked(
-    const Solver&,
+    const Solver& solver,
     Learning* strategy,
-    Literal )
+    Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
-        if( !strategy->onNavigatingLiteralForAllMarked( at( trail[ i ] ) ) )
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        Literal l = literals[ i ];
+        if( solver.isFalse( l ) && l.getVariable() != lit.getVariable() && !strategy->onNavigatingLiteralForAllMarked( l ) )
             return false;
+    }
 
     return true;            
 }
@@ -141,14 +168,22 @@ CardinalityConstraint::checkConsistent(
     Solver& solver )
 {
     assert( solver.getCurrentDecisionLevel() == 0 );
+    unsigned int notFalse = 0;
     for( unsigned int i = 0; i < literals.size(); i++ )
-        if( solver.isFalse( literals[ i ] ) )
-        {            
-            if( maxFalse == 0 )
-                return false;
-            onLiteralFalse( solver, literals[ i ], i );
+        if( !solver.isFalse( literals[ i ] ) )
+            notFalse++;
+
+    if( notFalse < bound )
+        return false;
+    if( notFalse > bound )
+        return true;
+
+    for( unsigned int i = 0; i < literals.size(); i++ )
+        if( solver.isUndefined( literals[ i ] ) )
+        {
+            solver.assignLiteral( literals[ i ], this );
             if( solver.conflictDetected() )
                 return false;
         }
     return true;    
-}
\ No newline at end of file
+}
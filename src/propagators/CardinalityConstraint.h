@@ -47,9 +47,18 @@ class CardinalityConstraint : public Propagator, public Reason
         
         inline unsigned int size() const { return literals.size(); }
 
-        inline void addLiteral( Literal lit ) { literals.push_back( lit ); inTrail.push_back( false ); }        
-        inline bool setBound( uint64_t b ){ bound = b; maxFalse = literals.size() - b; return literals.size() >= b; }
+        inline void addLiteral( Literal lit ) { literals.push_back( lit ); }        
+        inline bool setBound( uint64_t b ){ bound = b; return literals.size() >= b; }
+        inline uint64_t getBound() const { return bound; }
         bool checkConsistent( Solver& solver );
+
+        /**
+         * Watches bound + 1 literals, which are kept in the first positions.
+         * When a watched literal becomes false it is swapped with a literal
+         * that is not false. If there is none, the other watched literals
+         * are inferred as true.
+         */
+        void attach( Solver& solver );
         
         inline Literal operator[]( unsigned int idx ) const { assert_msg( idx < literals.size(), idx << ">=" << literals.size() ); return literals[ idx ]; }
         inline Literal& operator[]( unsigned int idx ) { assert_msg( idx < literals.size(), idx << ">=" << literals.size() ); return literals[ idx ]; }
@@ -64,13 +73,10 @@ class CardinalityConstraint : public Propagator, public Reason
 
     private:
         inline CardinalityConstraint( const CardinalityConstraint& orig );
-        inline Literal at( unsigned int pos ) { assert( pos < literals.size() ); return literals[ pos ]; }
+        inline unsigned int numberOfWatches() const { return bound < literals.size() ? bound + 1 : literals.size(); }
         
         vector< Literal > literals;
         uint64_t bound;
-        uint64_t maxFalse;
-        vector< unsigned int > trail;
-        vector< bool > inTrail;
 };
 
 CardinalityConstraint::CardinalityConstraint() : Propagator(), bound( 0 )
@@ -81,10 +87,7 @@ CardinalityConstraint::CardinalityConstraint(
     const vector< Literal >& lits ) : Propagator(), bound( 0 )
 {
     for( unsigned int i = 0; i < lits.size(); i++ )
-    {
         literals.push_back( lits[ i ] );
-        inTrail.push_back( false );
-    }
 }
 
 #endif
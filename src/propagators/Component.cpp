@@ -291,10 +291,10 @@ Component::iterationOnSupportedByThisExternal(
     for( ; i < wl.size(); ++i )
     {
         Var variable = wl[ j ] = wl[ i ];
-        assert( solver.getComponent( variable ) != NULL );
         trace_msg( unfoundedset, 3, "Considering variable " << Literal( variable, POSITIVE ) << " which is " << ( solver.isFalse( variable ) ? "false" : "true" ) << " and " << ( ( getGUSData( variable ).isInQueue() ) ? "in queue" : "not in queue" ) );        
         assert( !getGUSData( variable ).isInQueue() || variablesWithoutSourcePointer.existElement( variable ) );
-        if( solver.getComponent( variable )->getId() != id || solver.isFalse( variable ) )
+        //The variable may belong to another component, or to a component that has been removed.
+        if( solver.getComponent( variable ) != this || solver.isFalse( variable ) )
         {            
             ++j;
             continue;
@@ -323,7 +323,7 @@ Component::iterationOnSupportedByThisInternal(
     for( ; i < wl.size(); ++i )
     {
         Var variable = wl[ j ] = wl[ i ];
-        assert( solver.getComponent( variable ) != NULL && solver.getComponent( variable )->getId() == id );
+        assert( solver.getComponent( variable ) == this );
         trace_msg( unfoundedset, 3, "Considering variable " << Literal( variable, POSITIVE ) << " which is " << ( solver.isFalse( variable ) ? "false" : "true" ) << " and " << ( ( getGUSData( variable ).isInQueue() ) ? "in queue" : "not in queue" ) );
         assert( !getGUSData( variable ).isInQueue() || variablesWithoutSourcePointer.existElement( variable ) );
         if( solver.isFalse( variable ) )
@@ -349,11 +349,11 @@ Component::iterationOnAuxSupportedByThis(
     Literal lit )
 {
     trace_msg( unfoundedset, 2, "Iterating on aux variable supported by literal " << lit );
-    vector< Var >& vec = getGUSData( lit.getVariable() ).auxVariablesSupportedByThis[ lit.getSign() ];
-    
-    for( unsigned int i = 0; i < vec.size(); i++ )
+    const FrozenLists< Var >& vec = gusLists.auxVariablesSupportedByThis;
+    unsigned int index = lit.getIndex();
+    for( unsigned int i = 0; i < vec.size( index ); i++ )
     {
-        Var variable = vec[ i ];
+        Var variable = vec.get( index, i );
         assert( getGUSData( variable ).isAux() );
         trace_msg( unfoundedset, 3, "Considering variable " << Literal( variable, POSITIVE ) << " which is " << ( solver.isFalse( variable ) ? "false" : "true/undefined" ) << " and " << ( ( getGUSData( variable ).isInQueue() ) ? "in queue" : "not in queue" ) );
         if( solver.isFalse( variable ) )
@@ -373,35 +373,36 @@ Component::iterationOnAuxSupportedByThis(
 
 void
 Component::foundSourcePointer(
-    Var variableWithSourcePointer,
-    vector< Var >& vars,
-    vector< Literal >& lits )
+    Var variableWithSourcePointer )
 {
     assert( getGUSData( variableWithSourcePointer ).isFounded() );
-    for( unsigned int i = 0; i < getGUSData( variableWithSourcePointer ).possiblySupportedByThis[ POSITIVE ].size(); i++ )
+    unsigned int index = Literal( variableWithSourcePointer, POSITIVE ).getIndex();
+    const FrozenLists< Var >& possiblySupportedByThis = gusLists.possiblySupportedByThis;
+    for( unsigned int i = 0; i < possiblySupportedByThis.size( index ); i++ )
     {
-        Var var = getGUSData( variableWithSourcePointer ).possiblySupportedByThis[ POSITIVE ][ i ];
+        Var var = possiblySupportedByThis.get( index, i );
         assert( solver.getComponent( var ) == this );
         if( !solver.isFalse( var ) && !getGUSData( var ).isFounded() )
         {
             trace_msg( unfoundedset, 1, "Literal " << Literal( variableWithSourcePointer ) << " is a source pointer of " << Literal( var, POSITIVE ) ); 
-            vars.push_back( var );
-            lits.push_back( Literal( variableWithSourcePointer ) );
+            sourcePointerVars.push_back( var );
+            sourcePointerLits.push_back( Literal( variableWithSourcePointer ) );
 //            propagateSourcePointer( var, Literal( variableWithSourcePointer ) );
         }
     }
     
-    for( unsigned int i = 0; i < getGUSData( variableWithSourcePointer ).auxVariablesSupportedByThis[ POSITIVE ].size(); i++ )
+    const FrozenLists< Var >& auxVariablesSupportedByThis = gusLists.auxVariablesSupportedByThis;
+    for( unsigned int i = 0; i < auxVariablesSupportedByThis.size( index ); i++ )
     {        
-        Var var = getGUSData( variableWithSourcePointer ).auxVariablesSupportedByThis[ POSITIVE ][ i ];
+        Var var = auxVariablesSupportedByThis.get( index, i );
         assert( solver.getComponent( var ) == this );
         if( solver.isFalse( var ) )
             continue;
         
         trace_msg( unfoundedset, 1, "Literal " << Literal( variableWithSourcePointer ) << " is a source pointer of " << Literal( var, POSITIVE ) );        
         assert_msg( !getGUSData( var ).isFounded(), "Variable " << Literal( var, POSITIVE ) << " is founded" );
-        vars.push_back( var );
-        lits.push_back( Literal( variableWithSourcePointer ) );
+        sourcePointerVars.push_back( var );
+        sourcePointerLits.push_back( Literal( variableWithSourcePointer ) );
 //        propagateSourcePointer( var, Literal( variableWithSourcePointer ) );        
     }
 }
@@ -414,10 +415,10 @@ Component::lookForANewSourcePointer(
         return;
     
     Literal lit = Literal::null;
-    vector< Literal >& externalLiterals = getGUSData( var ).externalLiterals;
-    for( unsigned int i = 0; i < externalLiterals.size(); i++ )
+    const FrozenLists< Literal >& externalLiterals = gusLists.externalLiterals;
+    for( unsigned int i = 0; i < externalLiterals.size( var ); i++ )
     {
-        lit = externalLiterals[ i ];
+        lit = externalLiterals.get( var, i );
         if( solver.isFalse( lit ) )
             continue;
         trace_msg( unfoundedset, 1, "Literal " << lit << " is an external source pointer of " << Literal( var, POSITIVE ) );
@@ -425,10 +426,10 @@ Component::lookForANewSourcePointer(
         return;
     }
 
-    vector< Literal >& internalLiterals = getGUSData( var ).internalLiterals;
-    for( unsigned int i = 0; i < internalLiterals.size(); i++ )
+    const FrozenLists< Literal >& internalLiterals = gusLists.internalLiterals;
+    for( unsigned int i = 0; i < internalLiterals.size( var ); i++ )
     {
-        lit = internalLiterals[ i ];
+        lit = internalLiterals.get( var, i );
         if( solver.isFalse( lit ) || !getGUSData( lit.getVariable() ).isFounded() )
             continue;
         trace_msg( unfoundedset, 1, "Literal " << lit << " is an internal source pointer of " << Literal( var, POSITIVE ) );
@@ -457,17 +458,17 @@ Component::onLearningForUnfounded(
     if( getGUSData( id ).isAux() )
         return;
     
-    for( unsigned int i = 0; i < getGUSData( id ).externalLiterals.size(); i++ )
+    for( unsigned int i = 0; i < gusLists.externalLiterals.size( id ); i++ )
     {
-        Literal literal = getGUSData( id ).externalLiterals[ i ];
+        Literal literal = gusLists.externalLiterals.get( id, i );
         assert( solver.isFalse( literal ) );
         if( solver.getDecisionLevel( literal ) > 0 )
             learning.onNavigatingLiteralForUnfoundedSetLearning( literal );        
     }
 
-    for( unsigned int i = 0; i < getGUSData( id ).internalLiterals.size(); i++ )
+    for( unsigned int i = 0; i < gusLists.internalLiterals.size( id ); i++ )
     {
-        Literal literal = getGUSData( id ).internalLiterals[ i ];
+        Literal literal = gusLists.internalLiterals.get( id, i );
         assert( solver.getComponent( literal.getVariable() ) == this );
         if( solver.getDecisionLevel( literal ) > 0 && !getGUSData( literal.getVariable() ).isInUnfoundedSet() ) //getGUSData( literal.getVariable() ).isFounded() )
         {
@@ -638,14 +639,14 @@ Component::computeUnfoundedSet(
         
         if( getGUSData( next ).isAux() )
         {
-            vector< Literal >& literals = getGUSData( next ).literals;
+            const FrozenLists< Literal >& literals = gusLists.literals;
             #ifndef NDEBUG
             unsigned int count = 0;
             #endif
 
-            for( unsigned int j = 0; j < literals.size(); j++ )
+            for( unsigned int j = 0; j < literals.size( next ); j++ )
             {
-                Literal currentLiteral = literals[ j ];
+                Literal currentLiteral = literals.get( next, j );
                 Var currentVariable = currentLiteral.getVariable();
                 assert( !solver.isFalse( currentLiteral ) );                
                 if( currentLiteral.isNegative() || solver.getComponent( currentVariable ) != this || getGUSData( currentVariable ).isFounded() )
@@ -665,10 +666,10 @@ Component::computeUnfoundedSet(
         }
 
         bool hasSource = false;
-        vector< Literal >& externalLiterals = getGUSData( next ).externalLiterals;        
-        for( unsigned int j = 0; j < externalLiterals.size(); j++ )
+        const FrozenLists< Literal >& externalLiterals = gusLists.externalLiterals;
+        for( unsigned int j = 0; j < externalLiterals.size( next ); j++ )
         {
-            Literal lit = externalLiterals[ j ];
+            Literal lit = externalLiterals.get( next, j );
             if( solver.isFalse( lit ) )
                 continue;
 
@@ -681,10 +682,10 @@ Component::computeUnfoundedSet(
         if( hasSource )
             continue;
 
-        vector< Literal >& internalLiterals = getGUSData( next ).internalLiterals;
-        for( unsigned int j = 0; j < internalLiterals.size(); j++ )
+        const FrozenLists< Literal >& internalLiterals = gusLists.internalLiterals;
+        for( unsigned int j = 0; j < internalLiterals.size( next ); j++ )
         {
-            Literal lit = internalLiterals[ j ];
+            Literal lit = internalLiterals.get( next, j );
             assert( lit.isPositive() );
             if( solver.isFalse( lit ) )
                 continue;
@@ -742,23 +743,27 @@ Component::propagateSourcePointer(
     Var var,
     Literal literal )
 {
-    vector< Var > vars;
-    vector< Literal > lits;
-    vars.push_back( var );
-    lits.push_back( literal );
-    while( !vars.empty() )
+    assert( sourcePointerVars.empty() && sourcePointerLits.empty() );
+    sourcePointerVars.push_back( var );
+    sourcePointerLits.push_back( literal );
+    while( !sourcePointerVars.empty() )
     {
-        Var var = vars.back();
-        Literal literal = lits.back();
+        Var var = sourcePointerVars.back();
+        Literal literal = sourcePointerLits.back();
         
-        vars.pop_back();
-        lits.pop_back();
+        sourcePointerVars.pop_back();
+        sourcePointerLits.pop_back();
         assert( !solver.isFalse( var ) );
         if( getGUSData( var ).isFounded() )
             continue;
         if( getGUSData( var ).isAux() )
         {
-            assert( find( getGUSData( var ).literals.begin(), getGUSData( var ).literals.end(), literal ) != getGUSData( var ).literals.end() );
+            #ifndef NDEBUG
+            bool found = false;
+            for( unsigned int i = 0; i < gusLists.literals.size( var ) && !found; i++ )
+                found = gusLists.literals.get( var, i ) == literal;
+            assert( found );
+            #endif
             assert( getGUSData( var ).numberOfSupporting > 0 );
             getGUSData( var ).numberOfSupporting--;
             if( getGUSData( var ).numberOfSupporting > 0 )
@@ -771,8 +776,8 @@ Component::propagateSourcePointer(
         }
 
         setFounded( var );
-        foundSourcePointer( var, vars, lits );
-        assert( vars.size() == lits.size() );
+        foundSourcePointer( var );
+        assert( sourcePointerVars.size() == sourcePointerLits.size() );
     }
 }
 
@@ -854,6 +859,87 @@ Component::hasToAddClause() const
     return !done;
 }
 
+void
+Component::addUndecidedDependencies(
+    DependencyGraph& graph,
+    vector< unsigned int >& missing )
+{
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    assert( missing.size() >= gusData.size() );
+
+    //missing[ v ] is 0 if v is false or cannot be unfounded anymore.
+    //Otherwise it is 1 for atoms, which need one support, and the number of
+    //positive internal literals for aux variables, which need all of them.
+    Vector< Var > founded;
+    for( unsigned int i = 0; i < variablesInComponent.size(); i++ )
+    {
+        Var var = variablesInComponent[ i ];
+        missing[ var ] = 0;
+        if( solver.isFalse( var ) )
+            continue;
+
+        if( getGUSData( var ).isAux() )
+        {
+            for( unsigned int j = 0; j < gusLists.literals.size( var ); j++ )
+            {
+                Literal lit = gusLists.literals.get( var, j );
+                if( lit.isPositive() && solver.getComponent( lit.getVariable() ) == this )
+                    missing[ var ]++;
+            }
+        }
+        else
+        {
+            missing[ var ] = 1;
+            for( unsigned int j = 0; j < gusLists.externalLiterals.size( var ); j++ )
+                if( solver.isTrue( gusLists.externalLiterals.get( var, j ) ) )
+                    missing[ var ] = 0;
+        }
+
+        if( missing[ var ] == 0 )
+            founded.push_back( var );
+    }
+
+    //An atom with a founded internal support true at level 0 is founded.
+    while( !founded.empty() )
+    {
+        Var var = founded.back();
+        founded.pop_back();
+        unsigned int index = Literal( var, POSITIVE ).getIndex();
+        for( unsigned int i = 0; i < gusLists.possiblySupportedByThis.size( index ); i++ )
+        {
+            Var supported = gusLists.possiblySupportedByThis.get( index, i );
+            if( missing[ supported ] == 0 || !solver.isTrue( var ) )
+                continue;
+            missing[ supported ] = 0;
+            founded.push_back( supported );
+        }
+
+        for( unsigned int i = 0; i < gusLists.auxVariablesSupportedByThis.size( index ); i++ )
+        {
+            Var supported = gusLists.auxVariablesSupportedByThis.get( index, i );
+            if( missing[ supported ] == 0 || --missing[ supported ] > 0 )
+                continue;
+            founded.push_back( supported );
+        }
+    }
+
+    for( unsigned int i = 0; i < variablesInComponent.size(); i++ )
+    {
+        Var var = variablesInComponent[ i ];
+        if( missing[ var ] == 0 )
+            continue;
+
+        const FrozenLists< Literal >& internal = getGUSData( var ).isAux() ? gusLists.literals : gusLists.internalLiterals;
+        for( unsigned int j = 0; j < internal.size( var ); j++ )
+        {
+            Literal lit = internal.get( var, j );
+            Var dependency = lit.getVariable();
+            if( lit.isPositive() && dependency != var && solver.getComponent( dependency ) == this && missing[ dependency ] > 0 )
+                graph.addEdge( var, dependency );
+        }
+    }
+}
+
 #ifndef NDEBUG
 bool
 Component::checkSourcePointersStatus()
@@ -861,7 +947,7 @@ Component::checkSourcePointersStatus()
     for( unsigned int i = 0; i < variablesInComponent.size(); i++ )
     {
         unsigned int id = variablesInComponent[ i ];                
-        assert( solver.getComponent( id )->getId() == this->id );
+        assert( solver.getComponent( id ) == this );
         if( !getGUSData( id ).isFounded() )
         {
             cerr << "Variable " << Literal( id, POSITIVE ) << " is not founded " << getGUSData( id ).numberOfSupporting << endl;
@@ -884,7 +970,7 @@ Component::checkFoundedStatus()
     for( unsigned int i = 0; i < variablesInComponent.size(); i++ )
     {
         unsigned int var = variablesInComponent[ i ];
-        assert( solver.getComponent( var )->getId() == this->id );        
+        assert( solver.getComponent( var ) == this );
         assert_msg( !variablesWithoutSourcePointer.existElement( var ), "VariablesWithoutSourcePointer contains " << Literal( var, POSITIVE ) );
         assert_msg( getGUSData( var ).isFounded(), Literal( var, POSITIVE ) << " is not founded" );
         assert_msg( !getGUSData( var ).isInQueue(), Literal( var, POSITIVE ) << " is in queue" );
@@ -34,6 +34,7 @@
 class Learning;
 class Solver;
 class Clause;
+class DependencyGraph;
 using namespace std;
 
 //typedef unsigned int heap_handle;
@@ -48,7 +49,7 @@ class Component : public PostPropagator
 {
     friend ostream& operator<<( ostream& o, const Component& c );
     public:
-        inline Component( vector< GUSData* >& gusData_, Solver& s ) : PostPropagator(), solver( s ), gusData( gusData_ ), clauseToPropagate( NULL ), conflict( 0 ), id( 0 ), done( 0 ), first( 1 ), removed( 0 ), numberOfCalls( 0 ) {}
+        inline Component( vector< GUSData* >& gusData_, GUSLists& gusLists_, Solver& s ) : PostPropagator(), solver( s ), gusData( gusData_ ), gusLists( gusLists_ ), clauseToPropagate( NULL ), conflict( 0 ), id( 0 ), done( 0 ), first( 1 ), removed( 0 ), numberOfCalls( 0 ) {}
         ~Component();        
         
         virtual bool onLiteralFalse( Literal lit );
@@ -68,8 +69,8 @@ class Component : public PostPropagator
         inline void setAuxVariable( unsigned int varId ) { getGUSData( varId ).setAux(); }
         inline void addExternalLiteralForVariable( unsigned int varId, Literal lit ) { addExternalLiteral( varId, lit ); /*getGUSData( varId ).externalLiterals.push_back( lit );*/ }
         inline void addInternalLiteralForVariable( unsigned int varId, Literal lit ) { addInternalLiteral( varId, lit ); /*getGUSData( varId ).internalLiterals.push_back( lit );*/ }
-        inline void addVariablePossiblySupportedByLiteral( Var var, Literal lit ) { gusData[ lit.getVariable() ]->possiblySupportedByThis[ lit.getSign() ].push_back( var ); }
-        inline void addAuxVariableSupportedByLiteral( Var var, Literal lit ) { gusData[ lit.getVariable() ]->auxVariablesSupportedByThis[ lit.getSign() ].push_back( var ); }
+        inline void addVariablePossiblySupportedByLiteral( Var var, Literal lit ) { gusLists.possiblySupportedByThis.add( lit.getIndex(), var ); }
+        inline void addAuxVariableSupportedByLiteral( Var var, Literal lit ) { gusLists.auxVariablesSupportedByThis.add( lit.getIndex(), var ); }
         
         inline void variableHasNoSourcePointer( Var var );
         void onLearningForUnfounded( unsigned int id, Learning& );
@@ -79,6 +80,14 @@ class Component : public PostPropagator
         
         Clause* inferFalsityOfUnfoundedAtoms();
         void conflictOnUnfoundedAtom( Clause* clause, Var variable );                
+
+        /**
+         * Adds to graph the positive dependencies among the atoms of the
+         * component that can still be unfounded, skipping the atoms that are
+         * false at level 0 and those with a support true at level 0.
+         * missing is a vector indexed by variable used as working space.
+         */
+        void addUndecidedDependencies( DependencyGraph& graph, vector< unsigned int >& missing );
         
     protected:
         virtual void reset();
@@ -88,6 +97,7 @@ class Component : public PostPropagator
         Solver& solver;
         vector< unsigned int > variablesInComponent;
         vector< GUSData* >& gusData;
+        GUSLists& gusLists;
         Vector< Var > variablesWithoutSourcePointer;
         Vector< Var > unfoundedSet;
         Clause* clauseToPropagate;
@@ -102,6 +112,12 @@ class Component : public PostPropagator
         
         vector< unsigned int > added;
         unsigned int numberOfCalls;
+
+        /**
+         * The variables whose source pointer is being propagated, and their source pointers.
+         */
+        Vector< Var > sourcePointerVars;
+        Vector< Literal > sourcePointerLits;
         
         bool propagateFalseForGUS( Literal lit );
         inline void propagateLiteralLostSourcePointer( Literal lit );
@@ -109,7 +125,7 @@ class Component : public PostPropagator
         bool iterationOnSupportedByThisInternal( Literal lit );
         void iterationOnAuxSupportedByThis( Literal lit );        
 
-        void foundSourcePointer( Var var, vector< Var >& vars, vector< Literal >& lits );
+        void foundSourcePointer( Var var );
         inline void lookForANewSourcePointer( Var var );
         void propagateSourcePointer( Var var, Literal literal );
         inline void addExternalLiteral( Var var, Literal literal );
@@ -174,9 +190,9 @@ Component::addExternalLiteral(
     Literal literal )
 {
     if( !getGUSData( var ).isAux() )
-        getGUSData( var ).externalLiterals.push_back( literal );
+        gusLists.externalLiterals.add( var, literal );
     else
-        getGUSData( var ).literals.push_back( literal ); 
+        gusLists.literals.add( var, literal );
 }
 
 void
@@ -185,9 +201,9 @@ Component::addInternalLiteral(
     Literal literal )
 {
     if( !getGUSData( var ).isAux() )
-        getGUSData( var ).internalLiterals.push_back( literal );
+        gusLists.internalLiterals.add( var, literal );
     else
-        getGUSData( var ).literals.push_back( literal );
+        gusLists.literals.add( var, literal );
 }
 
 void
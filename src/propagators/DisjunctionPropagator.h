@@ -40,6 +40,11 @@ class DisjunctionPropagator : public Propagator
         inline void addOriginalAndAuxLiterals( Literal origLit, Literal auxLit );
         void finalize( Solver& solver );        
 
+        inline unsigned int size() const { return origLiterals.size() - 1; }
+        inline Literal getBodyLiteral() const { return startPos == 0 ? origLiterals[ 0 ].getOppositeLiteral() : Literal::null; }
+        inline Literal getOriginalLiteral( unsigned int i ) const { assert( i > 0 && i < origLiterals.size() ); return origLiterals[ i ]; }
+        inline Literal getAuxLiteral( unsigned int i ) const { assert( i > 0 && i < auxLiterals.size() ); return auxLiterals[ i ]; }
+
     private:
         inline DisjunctionPropagator( const DisjunctionPropagator& orig );
         
@@ -22,6 +22,7 @@
 #include "../stl/Vector.h"
 #include "../Solver.h"
 #include "../Clause.h"
+#include "../interpreters/MyNativeInterpreter.h"
 #include "../interpreters/MyPerlInterpreter.h"
 #include "../interpreters/MyPythonInterpreter.h"
 #include "../util/WaspOptions.h"
@@ -68,6 +69,8 @@ ExternalPropagator::ExternalPropagator(
         interpreter = new MyPythonInterpreter( fn, scriptDirectory, wasp::Options::callPyFinalize );
     else if( interpr == PERL_INTERPRETER )
         interpreter = new MyPerlInterpreter( fn, scriptDirectory );
+    else if( interpr == NATIVE_INTERPRETER )
+        interpreter = new MyNativeInterpreter( fn, scriptDirectory );
     else
         WaspErrorMessage::errorGeneric( "Unsupported interpreter" );
     check_addedVarName = interpreter->checkMethod( method_plugins_addedVarName );
@@ -477,6 +480,12 @@ ExternalPropagator::checkPartialInterpretation(
     bool retValue = true;
     if( check_checkPartialInterpretation )
     {
+        //A check of a total interpretation is never skipped.
+        if( wasp::Options::adaptivePartialChecks && solver.numberOfAssignedLiterals() < solver.numberOfVariables() && !partialChecks.hasToCheck() )
+        {
+            statistics( &solver, skipExternalPartialCheck() );
+            return true;
+        }
         vector< int > interpretation;
         interpretation.push_back( solver.getCurrentDecisionLevel() );
         for( unsigned int i = 1; i <= solver.numberOfVariables(); i++ )
@@ -487,6 +496,8 @@ ExternalPropagator::checkPartialInterpretation(
                 interpretation.push_back( -i );
         }
         retValue = interpreter->callIntMethod( method_plugins_checkPartialInterpretation, interpretation ) != 0;
+        statistics( &solver, onExternalPartialCheck( !retValue ) );
+        partialChecks.onCheck( !retValue );
     }
     return retValue;
 }
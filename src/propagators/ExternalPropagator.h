@@ -19,6 +19,7 @@
 #ifndef WASP_EXTERNALPROPAGATOR_H
 #define WASP_EXTERNALPROPAGATOR_H
 
+#include "PartialCheckScheduler.h"
 #include "Propagator.h"
 #include "../stl/Vector.h"
 class Clause;
@@ -116,6 +117,8 @@ class ExternalPropagator : public Propagator
         
         vector< int > weakConstraints;
         vector< uint64_t > weights;
+
+        PartialCheckScheduler partialChecks;
 };
 
 #endif
@@ -29,6 +29,25 @@ operator<<(
     return aggregate.print( out );
 }
 
+unsigned int
+MultiAggregate::hasBound(
+    uint64_t bound ) const
+{
+    vector< uint64_t >::const_iterator it = lower_bound( bounds.begin(), bounds.end(), bound );
+    return ( it != bounds.end() && *it == bound ) ? it - bounds.begin() : UINT_MAX;
+}
+
+void
+MultiAggregate::addBound(
+    Literal boundId,
+    uint64_t bound )
+{
+    unsigned int position = lower_bound( bounds.begin(), bounds.end(), bound ) - bounds.begin();
+    assert( position == bounds.size() || bounds[ position ] != bound );
+    bounds.insert( bounds.begin() + position, bound );
+    ids.insert( ids.begin() + position, boundId );
+}
+
 bool
 MultiAggregate::onLiteralFalse( Solver& solver, Literal lit, PropagatorData propData )
 {
@@ -219,80 +238,115 @@ MultiAggregate::reset( const Solver& solver )
 void MultiAggregate::onLearning( const Solver& solver, Learning* strategy, Literal lit )
 {
     vector< Literal > inferences;
-    computeInferences( inferences, lit.getOppositeLiteral() );
+    computeInferences( solver, inferences, lit.getOppositeLiteral() );
     for( unsigned int i = 0; i < inferences.size(); i++ )
-        if( solver.getDecisionLevel( inferences[ i ] ) > 0 )
-            strategy->onNavigatingLiteral( inferences[ i ].getOppositeLiteral() );  
+        strategy->onNavigatingLiteral( inferences[ i ].getOppositeLiteral() );  
 }
 
 void MultiAggregate::onNavigatingForUnsatCore( const Solver& solver, vector<unsigned int>& visited, unsigned int numberOfCalls, Literal lit )
 {
     vector< Literal > inferences;
-    computeInferences( inferences, lit.getOppositeLiteral() );
+    computeInferences( solver, inferences, lit.getOppositeLiteral() );
     for( unsigned int i = 0; i < inferences.size(); i++ )
-        if( solver.getDecisionLevel( inferences[ i ] ) > 0 )
-            visited[ inferences[ i ].getVariable() ] = numberOfCalls;        
+        visited[ inferences[ i ].getVariable() ] = numberOfCalls;        
 }
 
-bool MultiAggregate::onNavigatingLiteralForAllMarked( const Solver&, Learning* strategy, Literal lit )
+bool MultiAggregate::onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit )
 {
     vector< Literal > inferences;
-    computeInferences( inferences, lit.getOppositeLiteral() );    
+    computeInferences( solver, inferences, lit.getOppositeLiteral() );    
     for( unsigned int i = 0; i < inferences.size(); i++ )
         if( !strategy->onNavigatingLiteralForAllMarked( inferences[ i ].getOppositeLiteral() ) )
             return false;
     return true;
 }
 
-void MultiAggregate::computeInferences( vector< Literal >& inferences, Literal lit )
+void MultiAggregate::computeInferences( const Solver& solver, vector< Literal >& inferences, Literal lit )
 {
     assert_msg( positionInTrail.find( lit.getId() ) != positionInTrail.end(), "Cannot find " << lit << " in trail" );
     assert( inferences.empty() );
     unsigned int position = positionInTrail[ lit.getId() ];    
     assert_msg( position < trail.size(), position << " >= " << trail.size() );
-    trace_msg( multiaggregates, 3, "Computing inferences for literal " << lit );
-    computeInferences( inferences, position, trail[ position ].isId(), trail[ position ].position() );
-    trace_action( multiaggregates, 5, { trace_tag( cerr, multiaggregates, 5 ); cerr << "Inferences are:"; for( unsigned int i = 0; i < inferences.size(); i++ ) cerr << " " << inferences[ i ]; cerr << endl; } );
-}
+    bool isId = trail[ position ].isId();
+    int type = trail[ position ].position();
+    unsigned int index = abs( type );
+    trace_msg( multiaggregates, 3, "Computing inferences for literal " << lit << ": is id=" << ( isId ? "yes" : "no" ) << ", type=" << type );
 
-void MultiAggregate::computeInferences( vector< Literal >& inferences, unsigned int position, bool isId, int type )
-{
-    assert_msg( position < trail.size(), position << " >= " << trail.size() );
-    trace_msg( multiaggregates, 4, "Computing inferences: position=" << position << ", is id=" << ( isId ? "yes" : "no" ) << ", type=" << type );
-    if( isId )
+    //The inferred literal depends only on the literals assigned before it.
+    //If it is false the aggregate is violated.
+    unsigned int boundary = solver.isTrue( lit ) ? solver.getPositionInTrail( lit.getVariable() ) : MAXUNSIGNEDINT;
+
+    //True ids and false literals are inferred by true literals, the others by false literals.
+    bool fromTrueLiterals = ( isId == ( type > 0 ) );
+    int64_t sumOfWeights = 0;
+    int64_t weightAtLevelZero = 0;
+    bool keepAll = false;
+    explanation.clear();
+    for( unsigned int i = 1; i < literals.size(); i++ )
     {
-        for( unsigned int i = 0; i < position; i++ )
+        sumOfWeights += weights[ i ];
+        if( !isId && i == index )
+            continue;
+        if( literals[ i ].getVariable() == lit.getVariable() )
         {
-            assert_msg( i < trail.size(), i << " >= " << trail.size() );
-            int pos = trail[ i ].position();
-            bool sameSign = ( pos > 0 && type > 0 ) || ( pos < 0 && type < 0 );
-            if( sameSign && !trail[ i ].isId() )
-                inferences.push_back( pos > 0 ? literals[ pos ] : literals[ -pos ].getOppositeLiteral() );
+            keepAll = true;
+            continue;
         }
+        Literal l = fromTrueLiterals ? literals[ i ] : literals[ i ].getOppositeLiteral();
+        if( !solver.isTrue( l ) )
+            continue;
+        unsigned int level = solver.getDecisionLevel( l );
+        if( level == 0 )
+            weightAtLevelZero += weights[ i ];
+        else if( solver.getPositionInTrail( l.getVariable() ) < boundary )
+            explanation.addCandidate( l, weights[ i ], level );
     }
+
+    int64_t requiredWeight;
+    if( isId )
+        requiredWeight = type > 0 ? ( int64_t ) bounds[ index ] : sumOfWeights - ( int64_t ) bounds[ index ] + 1;
     else
     {
-        unsigned int lastId = UINT_MAX;        
-        for( unsigned int i = 0; i < position; i++ )
-        {
-            assert_msg( i < trail.size(), i << " >= " << trail.size() );
-            int pos = trail[ i ].position();
-            bool sameSign = ( pos > 0 && type > 0 ) || ( pos < 0 && type < 0 );
-            if( sameSign || trail[ i ].isId() )
-            {
-                if( sameSign && trail[ i ].isId() ) lastId = i;
-                continue;
-            }
-            if( abs( pos ) == abs( type ) ) continue;
-            inferences.push_back( pos > 0 ? literals[ pos ] : literals[ -pos ].getOppositeLiteral() );
-        }
-        if( lastId != UINT_MAX )
+        //A literal is inferred together with the true id with the greatest bound
+        //or the false id with the smallest bound.
+        unsigned int id = computeIdForInference( solver, type > 0, boundary );
+        if( id == UINT_MAX || id == ids.size() - 1 )
+            keepAll = true;
+        else
         {
-            assert_msg( lastId < trail.size(), lastId << " >= " << trail.size() );
-            int pos = trail[ lastId ].position();
-            inferences.push_back( pos > 0 ? ids[ pos ] : ids[ -pos ].getOppositeLiteral() );        
+            Literal l = type > 0 ? ids[ id ] : ids[ id ].getOppositeLiteral();
+            if( solver.getDecisionLevel( l ) > 0 )
+                inferences.push_back( l );
         }
+        requiredWeight = type > 0
+            ? sumOfWeights - ( int64_t ) weights[ index ] - ( keepAll ? 0 : ( int64_t ) bounds[ id ] ) + 1
+            : ( keepAll ? 0 : ( int64_t ) bounds[ id ] ) - ( int64_t ) weights[ index ];
+    }
+
+    if( !keepAll )
+        explanation.reduce( requiredWeight - weightAtLevelZero );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        inferences.push_back( explanation[ i ] );
+    trace_action( multiaggregates, 5, { trace_tag( cerr, multiaggregates, 5 ); cerr << "Inferences are:"; for( unsigned int i = 0; i < inferences.size(); i++ ) cerr << " " << inferences[ i ]; cerr << endl; } );
+}
+
+unsigned int MultiAggregate::computeIdForInference( const Solver& solver, bool trueId, unsigned int boundary ) const
+{
+    //w1 and w2 are restored only after the learning, so the id used by the
+    //inference is between them and the sentinels.
+    if( trueId )
+    {
+        for( int k = w1; k >= 0; k-- )
+            if( solver.isTrue( ids[ k ] ) && ( solver.getDecisionLevel( ids[ k ] ) == 0 || solver.getPositionInTrail( ids[ k ].getVariable() ) < boundary ) )
+                return k;
+    }
+    else
+    {
+        for( unsigned int k = w2; k < ids.size(); k++ )
+            if( solver.isFalse( ids[ k ] ) && ( solver.getDecisionLevel( ids[ k ] ) == 0 || solver.getPositionInTrail( ids[ k ].getVariable() ) < boundary ) )
+                return k;
     }
+    return UINT_MAX;
 }
 
 ostream&
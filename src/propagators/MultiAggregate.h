@@ -23,6 +23,7 @@ class Solver;
 #include "../Literal.h"
 
 #include "Propagator.h"
+#include "WeightedExplanation.h"
 #include "../Reason.h"
 #include "../util/WaspAssert.h"
 #include "../util/WaspOptions.h"
@@ -31,6 +32,7 @@ class Solver;
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
 #include <cstdlib>
 #include <numeric>
 using namespace std;
@@ -59,14 +61,13 @@ class MultiAggregate : public Propagator, public Reason
         virtual ~MultiAggregate() {}
         bool onLiteralFalse( Solver& solver, Literal literal, PropagatorData propData );        
         inline void addLiteral( Literal literal, uint64_t weight ) { literals.push_back( literal ); weights.push_back( weight ); maxPossibleSum += weight; }
-        inline unsigned int hasBound( uint64_t bound )
-        {
-            for( unsigned int i = 0; i < bounds.size(); i++ )
-                if( bounds[ i ] == bound )
-                    return i;
-            return UINT_MAX;
-        }
-        inline void addBound( Literal boundId, uint64_t bound ) { assert( hasBound( bound ) == UINT_MAX ); ids.push_back( boundId ); bounds.push_back( bound ); }
+
+        /**
+         * The bounds are kept sorted in increasing order.
+         * @return the position of the bound, or UINT_MAX if it has not been added
+         */
+        unsigned int hasBound( uint64_t bound ) const;
+        void addBound( Literal boundId, uint64_t bound );
                 
         void reset( const Solver& solver );
         void simplifyAtLevelZero( Solver& ) {}
@@ -75,10 +76,14 @@ class MultiAggregate : public Propagator, public Reason
         bool onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit );
         void onNavigatingForUnsatCore( const Solver& solver, vector< unsigned int >& visited, unsigned int numberOfCalls, Literal lit );        
         
-        inline void sort() { bubblesort( literals, weights, true ); bubblesort( ids, bounds, false ); }
+        inline void sort() { bubblesort( literals, weights ); }
         void attach( Solver& solver );
         
         inline Literal getId( unsigned int pos ) const { assert_msg( pos < ids.size(), pos << ">=" << ids.size() ); return ids[ pos ]; }        
+        inline uint64_t getWeight( unsigned int pos ) const { assert_msg( pos < weights.size(), pos << ">=" << weights.size() ); return weights[ pos ]; }
+        inline uint64_t getBound( unsigned int pos ) const { assert_msg( pos < bounds.size(), pos << ">=" << bounds.size() ); return bounds[ pos ]; }
+        inline Literal getLiteral( unsigned int pos ) const { assert_msg( pos < literals.size(), pos << ">=" << literals.size() ); return literals[ pos ]; }
+        inline unsigned int size() const { return literals.size() - 1; }
         
         inline void finalize( Solver& solver ) { sort(); addBound( Literal( 1, POSITIVE ), UINT64_MAX ); addBinaryClauses( solver ); assert( checkUndefined( solver ) ); }
         inline void finalizeNoBinaryClauses( Solver& 
@@ -107,9 +112,16 @@ class MultiAggregate : public Propagator, public Reason
         
         unordered_map<int, unsigned int> positionInTrail; 
         
+        /**
+         * ids[ w1 ] is the true id with the greatest bound and ids[ w2 ] is the
+         * false id with the smallest bound. They are moved only over the bounds
+         * crossed by the sum, and moved back by reset.
+         */
         unsigned int w1;
         unsigned int w2;        
         
+        WeightedExplanation explanation;
+        
         bool notificationIdLit( Solver&, Literal, int );
         bool notificationAggregateLit( Solver&, Literal, int );
         
@@ -118,14 +130,15 @@ class MultiAggregate : public Propagator, public Reason
         void checkFalseInference( Solver& solver, Literal lit );
         void checkTrueInference( Solver& solver, Literal lit );
         
-        inline uint64_t getWeight( unsigned int pos ) const { assert_msg( pos < weights.size(), pos << ">=" << weights.size() ); return weights[ pos ]; }
-        inline uint64_t getBound( unsigned int pos ) const { assert_msg( pos < bounds.size(), pos << ">=" << bounds.size() ); return bounds[ pos ]; }
-        inline Literal getLiteral( unsigned int pos ) const { assert_msg( pos < literals.size(), pos << ">=" << literals.size() ); return literals[ pos ]; }
         
         void addBinaryClauses( Solver& solver );
         
-        void computeInferences( vector< Literal >& inferences, Literal lit );
-        void computeInferences( vector< Literal >& inferences, unsigned int position, bool isId, int type );                
+        /**
+         * Computes the true literals, assigned before lit, that infer lit:
+         * the heaviest literals whose weight reaches the bound are chosen.
+         */
+        void computeInferences( const Solver& solver, vector< Literal >& inferences, Literal lit );
+        unsigned int computeIdForInference( const Solver& solver, bool trueId, unsigned int boundary ) const;
               
         void clean( Solver& solver );                
         
@@ -167,21 +180,13 @@ class MultiAggregate : public Propagator, public Reason
             elems[ j + 1 ] = tmp;
         }
         
-        void bubblesort( vector< Literal >& lits, vector< uint64_t >& ws, bool descOrd )
+        void bubblesort( vector< Literal >& lits, vector< uint64_t >& ws )
         {
             assert( lits.size() == ws.size() );
             for( int i = lits.size() - 1; i > 1; i-- ) {
                 bool swapped = false;
-                if( descOrd )
-                {
-                    for( int j = 1; j < i; j++ )
-                        if( ws[ j ] < ws[ j + 1 ] ) { swap( lits, j ); swap( ws, j ); swapped = true; }                    
-                }
-                else
-                {
-                    for( int j = 1; j < i; j++ )
-                        if( ws[ j ] > ws[ j + 1 ] ) { swap( lits, j ); swap( ws, j ); swapped = true; }                    
-                }
+                for( int j = 1; j < i; j++ )
+                    if( ws[ j ] < ws[ j + 1 ] ) { swap( lits, j ); swap( ws, j ); swapped = true; }                    
                 if( !swapped )
                     break;
             }
@@ -0,0 +1,64 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#ifndef WASP_PARTIALCHECKSCHEDULER_H
+#define WASP_PARTIALCHECKSCHEDULER_H
+
+#include "../util/WaspConstants.h"
+
+/**
+ * Decides when a check of a partial interpretation is performed.
+ * After a check that does not find a conflict the following checks are
+ * skipped for an interval that is doubled at each unsuccessful check,
+ * while a check that finds a conflict resets the interval.
+ */
+class PartialCheckScheduler
+{
+    public:
+        inline PartialCheckScheduler() : interval( 0 ), skipped( 0 ) {}
+
+        /**
+         * @return false if the current check has to be skipped
+         */
+        inline bool hasToCheck()
+        {
+            if( skipped < interval )
+            {
+                skipped++;
+                return false;
+            }
+            skipped = 0;
+            return true;
+        }
+
+        inline void onCheck( bool foundConflict )
+        {
+            if( foundConflict )
+                interval = 0;
+            else if( interval == 0 )
+                interval = 1;
+            else if( interval < PARTIAL_CHECKS_MAX_INTERVAL )
+                interval *= 2;
+        }
+
+    private:
+        unsigned int interval;
+        unsigned int skipped;
+};
+
+#endif
@@ -0,0 +1,367 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#include "PseudoBooleanConstraint.h"
+#include "../Solver.h"
+#include "../Learning.h"
+
+#include <algorithm>
+
+static bool
+heavierFirst(
+    const pair< uint64_t, Literal >& p1,
+    const pair< uint64_t, Literal >& p2 )
+{
+    return p1.first > p2.first;
+}
+
+bool
+PseudoBooleanConstraint::setBound(
+    uint64_t b )
+{
+    bound = b;
+    uint64_t sumOfWeights = 0;
+    for( unsigned int i = 0; i < weights.size(); i++ )
+    {
+        if( weights[ i ] > bound )
+            weights[ i ] = bound;
+        sumOfWeights += weights[ i ];
+    }
+    return sumOfWeights >= bound;
+}
+
+void
+PseudoBooleanConstraint::sort()
+{
+    vector< pair< uint64_t, Literal > > elements;
+    for( unsigned int i = 0; i < literals.size(); i++ )
+        elements.push_back( pair< uint64_t, Literal >( weights[ i ], literals[ i ] ) );
+    stable_sort( elements.begin(), elements.end(), heavierFirst );
+    for( unsigned int i = 0; i < elements.size(); i++ )
+    {
+        weights[ i ] = elements[ i ].first;
+        literals[ i ] = elements[ i ].second;
+    }
+}
+
+bool
+PseudoBooleanConstraint::attach(
+    Solver& solver )
+{
+    assert( !literals.empty() );
+    assert( trail.empty() && unattached.empty() );
+    int64_t sumOfWeights = 0;
+    int64_t falseWeight = 0;
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        assert_msg( i == 0 || weights[ i - 1 ] >= weights[ i ], "Weights must be sorted in decreasing order" );
+        sumOfWeights += weights[ i ];
+        if( solver.isFalse( literals[ i ] ) )
+            falseWeight += weights[ i ];
+    }
+
+    if( sumOfWeights - falseWeight < ( int64_t ) bound )
+    {
+        trace_msg( aggregates, 2, "Constraint " << *this << " is violated" );
+        return false;
+    }
+
+    counter = sumOfWeights - bound;
+    unattachedWeight = 0;
+    umax = 0;
+    nextUnattached = 0;
+    unattachedAreFalse = false;
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        if( !solver.isFalse( literals[ i ] ) )
+            continue;
+        attached[ i ] = false;
+        unattached.push_back( i );
+        unattachedWeight += weights[ i ];
+    }
+
+    //Lightest literals first: the heaviest ones are watched.
+    for( int i = literals.size() - 1; i >= 0; i-- )
+    {
+        if( !attached[ i ] || counter - unattachedWeight - ( int64_t ) weights[ i ] < maxWeight() )
+            continue;
+        attached[ i ] = false;
+        unattached.push_back( i );
+        unattachedWeight += weights[ i ];
+    }
+    trace_msg( aggregates, 2, "Watching " << ( literals.size() - unattached.size() ) << " literals out of " << literals.size() << " of " << *this );
+
+    for( unsigned int i = 0; i < literals.size(); i++ )
+        if( attached[ i ] )
+            solver.addPropagator( literals[ i ], this, PropagatorData( i ) );
+
+    //The literals inferred here are not in the trail, so umax is not used.
+    int64_t slack = counter - unattachedWeight;
+    for( unsigned int i = 0; i < literals.size() && ( int64_t ) weights[ i ] > slack; i++ )
+    {
+        if( !attached[ i ] || !solver.isUndefined( literals[ i ] ) )
+            continue;
+        trace_msg( aggregates, 9, "Inferring " << literals[ i ] << " as true" );
+        solver.assignLiteral( literals[ i ], this );
+    }
+    return true;
+}
+
+void
+PseudoBooleanConstraint::detach(
+    Solver& solver )
+{
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    for( unsigned int i = 0; i < literals.size(); i++ )
+        if( attached[ i ] )
+            solver.removePropagator( literals[ i ], this );
+}
+
+void
+PseudoBooleanConstraint::reset(
+    const Solver& solver )
+{
+    umax = 0;
+    unattachedAreFalse = false;
+    while( !trail.empty() && solver.isUndefined( literals[ trail.back() ] ) )
+    {
+        unsigned int i = trail.back();
+        trail.pop_back();
+        counter += weights[ i ];
+        counted[ i ] = false;
+    }
+    trace_msg( aggregates, 3, "Restored counter. Value: " << counter );
+}
+
+bool
+PseudoBooleanConstraint::onLiteralFalse(
+    Solver& solver,
+    Literal currentLiteral,
+    PropagatorData p )
+{
+    unsigned int index = p.position();
+    assert( index < literals.size() );
+    assert( literals[ index ] == currentLiteral );
+    assert( attached[ index ] && !counted[ index ] );
+    trace_msg( aggregates, 10, "PseudoBooleanConstraint: " << *this << ". Literal " << currentLiteral << " is false" );
+    bool levelZero = solver.getDecisionLevel( currentLiteral ) == 0;
+
+    if( attachWatches( solver, maxWeight() + weights[ index ] ) )
+    {
+        if( !levelZero )
+        {
+            trace_msg( aggregates, 2, "Enough weight is still watched: removing the watch of " << currentLiteral );
+            attached[ index ] = false;
+            unattached.push_back( index );
+            unattachedWeight += weights[ index ];
+            solver.detachCurrentPropagator();
+            return false;
+        }
+
+        counter -= weights[ index ];
+        counted[ index ] = true;
+        return false;
+    }
+
+    //All literals that are not watched are false.
+    int64_t slack = counter - unattachedWeight;
+    trace_msg( aggregates, 2, "Updating counter. Old value: " << counter << " - New value: " << counter - weights[ index ] << " - Slack: " << slack - weights[ index ] );
+    if( slack < ( int64_t ) weights[ index ] )
+    {
+        trace_msg( aggregates, 3, "A conflict happened." );
+        //The constraint is not reset if the conflict is the first event of this level.
+        unattachedAreFalse = false;
+        solver.assignLiteral( currentLiteral, this );
+        return false;
+    }
+
+    counter -= weights[ index ];
+    counted[ index ] = true;
+    if( !levelZero )
+        trail.push_back( index );
+
+    inferLiterals( solver, slack - weights[ index ] );
+    return !levelZero;
+}
+
+bool
+PseudoBooleanConstraint::attachWatches(
+    Solver& solver,
+    int64_t slack )
+{
+    if( counter - unattachedWeight >= slack )
+        return true;
+    if( unattachedAreFalse )
+        return false;
+
+    //The search starts where the previous one stopped, so that the literals
+    //that are false for a long time are not checked at each call.
+    unsigned int first = nextUnattached < unattached.size() ? nextUnattached : 0;
+    unsigned int i = first;
+    bool wrapped = false;
+    while( true )
+    {
+        if( i >= unattached.size() )
+        {
+            if( wrapped || first == 0 )
+                break;
+            wrapped = true;
+            i = 0;
+        }
+        if( wrapped && i >= first )
+            break;
+
+        unsigned int j = unattached[ i ];
+        if( solver.isFalse( literals[ j ] ) )
+        {
+            ++i;
+            continue;
+        }
+
+        trace_msg( aggregates, 3, "Watching " << literals[ j ] );
+        solver.addPropagator( literals[ j ], this, PropagatorData( j ) );
+        attached[ j ] = true;
+        unattachedWeight -= weights[ j ];
+        unattached[ i ] = unattached.back();
+        unattached.pop_back();
+        if( counter - unattachedWeight >= slack )
+        {
+            nextUnattached = i;
+            return true;
+        }
+    }
+    unattachedAreFalse = true;
+    return false;
+}
+
+void
+PseudoBooleanConstraint::inferLiterals(
+    Solver& solver,
+    int64_t slack )
+{
+    while( umax < literals.size() && ( int64_t ) weights[ umax ] > slack )
+    {
+        Literal lit = literals[ umax ];
+        if( attached[ umax ] && !counted[ umax ] && !solver.isTrue( lit ) )
+        {
+            trace_msg( aggregates, 9, "Inferring " << lit << " as true" );
+            solver.assignLiteral( lit, this );
+            if( solver.conflictDetected() )
+                return;
+        }
+        ++umax;
+    }
+}
+
+void
+PseudoBooleanConstraint::computeExplanation(
+    const Solver& solver,
+    Literal lit )
+{
+    //A literal is inferred when the weight of the false literals is greater
+    //than the sum of the weights minus the bound minus its weight.
+    explanation.clear();
+    unsigned int inferred = 0;
+    unsigned int occurrences = 0;
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        if( literals[ i ].getVariable() != lit.getVariable() )
+            continue;
+        inferred = i;
+        occurrences++;
+    }
+    assert( occurrences > 0 );
+
+    //A literal inferred by the constraint depends only on the literals false before it.
+    //If the literal of the constraint is false the constraint is violated.
+    unsigned int boundary = solver.isTrue( literals[ inferred ] ) ? solver.getPositionInTrail( lit.getVariable() ) : MAXUNSIGNEDINT;
+
+    int64_t sumOfWeights = 0;
+    int64_t weightAtLevelZero = 0;
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        sumOfWeights += weights[ i ];
+        Literal l = literals[ i ];
+        if( l.getVariable() == lit.getVariable() || !solver.isFalse( l ) )
+            continue;
+        unsigned int level = solver.getDecisionLevel( l );
+        if( level == 0 )
+            weightAtLevelZero += weights[ i ];
+        else if( solver.getPositionInTrail( l.getVariable() ) < boundary )
+            explanation.addCandidate( l, weights[ i ], level );
+    }
+
+    //If the variable occurs more than once all candidates are kept.
+    if( occurrences > 1 )
+        return;
+    explanation.reduce( sumOfWeights - ( int64_t ) bound - ( int64_t ) weights[ inferred ] + 1 - weightAtLevelZero );
+}
+
+void
+PseudoBooleanConstraint::onLearning(
+    const Solver& solver,
+    Learning* strategy,
+    Literal lit )
+{
+    computeExplanation( solver, lit );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        strategy->onNavigatingLiteral( explanation[ i ] );
+}
+
+void
+PseudoBooleanConstraint::onNavigatingForUnsatCore(
+    const Solver& solver,
+    vector< unsigned int >& visited,
+    unsigned int numberOfCalls,
+    Literal lit )
+{
+    computeExplanation( solver, lit );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        visited[ explanation[ i ].getVariable() ] = numberOfCalls;
+}
+
+bool
+PseudoBooleanConstraint::onNavigatingLiteralForAllMarked(
+    const Solver& solver,
+    Learning* strategy,
+    Literal lit )
+{
+    computeExplanation( solver, lit );
+    for( unsigned int i = 0; i < explanation.size(); i++ )
+        if( !strategy->onNavigatingLiteralForAllMarked( explanation[ i ] ) )
+            return false;
+    return true;
+}
+
+ostream&
+operator<<(
+    ostream& out,
+    const PseudoBooleanConstraint& pb )
+{
+    return pb.print( out );
+}
+
+ostream&
+PseudoBooleanConstraint::print( ostream& out ) const
+{
+    out << "#sum{";
+    for( unsigned int i = 0; i < literals.size(); i++ )
+        out << ( i > 0 ? ";" : "" ) << weights[ i ] << ":" << literals[ i ];
+    out << "} >= " << bound;
+    return out;
+}
@@ -0,0 +1,134 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#ifndef WASP_PSEUDOBOOLEANCONSTRAINT_H
+#define WASP_PSEUDOBOOLEANCONSTRAINT_H
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+#include "Propagator.h"
+#include "WeightedExplanation.h"
+#include "../Learning.h"
+#include "../Literal.h"
+#include "../Reason.h"
+#include "../stl/Vector.h"
+#include "../util/WaspTrace.h"
+
+class Solver;
+using namespace std;
+
+/**
+ * The constraint w_1 l_1 + ... + w_n l_n >= bound.
+ * The slack is the weight of the literals that are not false minus the bound:
+ * a literal whose weight is greater than the slack must be true.
+ * Only the heaviest literals needed to keep the slack above the maximum weight
+ * are watched, the others are watched when the watched weight is not enough.
+ * If no other literal can be watched all the unwatched literals are false and
+ * the slack is used to infer literals.
+ */
+class PseudoBooleanConstraint : public Propagator, public Reason
+{
+    friend ostream& operator<<( ostream& out, const PseudoBooleanConstraint& pb );
+    public:
+        inline PseudoBooleanConstraint() : Propagator(), counter( 0 ), unattachedWeight( 0 ), bound( 0 ), umax( 0 ), nextUnattached( 0 ), unattachedAreFalse( false ) {}
+        inline ~PseudoBooleanConstraint() {}
+
+        virtual bool onLiteralFalse( Solver& solver, Literal lit, PropagatorData p );
+        virtual void simplifyAtLevelZero( Solver& ) {}
+
+        inline unsigned int size() const { return literals.size(); }
+
+        inline void addLiteral( Literal lit, uint64_t weight ) { assert( weight > 0 ); literals.push_back( lit ); weights.push_back( weight ); counted.push_back( false ); attached.push_back( true ); }
+
+        inline Literal getLiteral( unsigned int i ) const { assert( i < literals.size() ); return literals[ i ]; }
+        inline uint64_t getWeight( unsigned int i ) const { assert( i < weights.size() ); return weights[ i ]; }
+        inline uint64_t getBound() const { return bound; }
+
+        /**
+         * Weights greater than the bound are replaced by the bound.
+         * @return false if the constraint cannot be satisfied
+         */
+        bool setBound( uint64_t b );
+
+        /**
+         * Sorts the literals by decreasing weight, as required by attach.
+         */
+        void sort();
+
+        /**
+         * Registers the constraint in the solver and infers the literals
+         * implied by the current assignment.
+         * Literals that are already false are not watched.
+         * @return false if the current assignment violates the constraint,
+         * in which case the solver is not modified
+         */
+        bool attach( Solver& solver );
+
+        /**
+         * Removes the watches of the constraint.
+         * It must be called at level 0.
+         */
+        void detach( Solver& solver );
+
+        virtual void reset( const Solver& solver );
+        virtual void onLearning( const Solver& solver, Learning* strategy, Literal lit );
+        virtual bool onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit );
+        virtual void onNavigatingForUnsatCore( const Solver& solver, vector< unsigned int >& visited, unsigned int numberOfCalls, Literal lit );
+
+    protected:
+        virtual ostream& print( ostream& out ) const;
+
+    private:
+        inline PseudoBooleanConstraint( const PseudoBooleanConstraint& orig );
+
+        vector< Literal > literals;
+        vector< uint64_t > weights;
+        vector< bool > counted;
+        vector< bool > attached;
+        Vector< unsigned int > unattached;
+        Vector< unsigned int > trail;
+
+        int64_t counter;
+        int64_t unattachedWeight;
+        uint64_t bound;
+        unsigned int umax;
+        unsigned int nextUnattached;
+
+        /**
+         * True if attachWatches failed: the unattached literals are false
+         * until the next reset, and they are not checked again.
+         */
+        bool unattachedAreFalse;
+
+        WeightedExplanation explanation;
+
+        inline int64_t maxWeight() const { assert( !weights.empty() ); return weights[ 0 ]; }
+
+        bool attachWatches( Solver& solver, int64_t slack );
+        void inferLiterals( Solver& solver, int64_t slack );
+
+        /**
+         * Computes in explanation the heaviest false literals, assigned before
+         * the inferred literal, whose weight is enough to infer it.
+         */
+        void computeExplanation( const Solver& solver, Literal lit );
+};
+
+#endif
@@ -12,17 +12,18 @@ ReductBasedCheck::ReductBasedCheck(
         numberOfAtoms( numberOfInputAtoms ), assumptionLiteral( Literal::null ), numberOfExternalLiterals( 0 ),
         numberOfInternalVariables( 0 ), numberOfZeroLevel( 0 ), removedHCVars( 0 ), literalToAdd( Literal::null )        
 {   
+    //The checker contains only the variables of the atoms occurring in the component.
     inUnfoundedSet.push_back( 0 );
     generatorToCheckerId.push_back( UINT_MAX );
-    while( checker.numberOfVariables() < numberOfInputAtoms )
+    generatorToCheckerTrueId.push_back( UINT_MAX );
+    for( unsigned int i = 0; i < numberOfInputAtoms; i++ )
     {
         inUnfoundedSet.push_back( 0 );
-        checker.addVariable();
         generatorToCheckerId.push_back( UINT_MAX );
+        generatorToCheckerTrueId.push_back( UINT_MAX );
     }
         
-    assert_msg( checker.numberOfVariables() == numberOfInputAtoms, checker.numberOfVariables() << " != " << numberOfInputAtoms );
-    assert( checker.numberOfVariables() == inUnfoundedSet.size() - 1 );
+    assert( numberOfInputAtoms == inUnfoundedSet.size() - 1 );
     initChecker();
 }
 
@@ -35,6 +36,7 @@ ReductBasedCheck::addExternalLiteral(
         if( inUnfoundedSet[ lit.getVariable() ] & 1 )
             return false;
         inUnfoundedSet[ lit.getVariable() ] |= 1;
+        addCheckerTrueVar( lit.getVariable() );
     }
     else
     {
@@ -100,6 +102,14 @@ ReductBasedCheck::testModel()
     if( isConflictual )
         return;
 
+    bool isPartial = trail.size() + numberOfZeroLevel != numberOfInternalVariables + numberOfExternalLiterals;
+    if( isPartial && wasp::Options::adaptivePartialChecks && !partialChecks.hasToCheck() )
+    {
+        trace_msg( modelchecker, 1, "Skipping partial check" );
+        statistics( &checker, skipPartialCheck() );
+        return;
+    }
+
     vector< Literal > assumptions;
     computeAssumptions( assumptions );
     //The checker will return always unsat
@@ -110,6 +120,8 @@ ReductBasedCheck::testModel()
         return;
     
     checkModel( assumptions );    
+    if( isPartial )
+        partialChecks.onCheck( !unfoundedSet.empty() );
     
     clearUnfoundedSetCandidates();        
 
@@ -143,7 +155,7 @@ ReductBasedCheck::iterationInternalLiterals(
         if( solver.isFalse( hcVariables[ i ] ) )
         {
             trace_msg( modelchecker, 4, "Adding in assumptions" );
-            assumptions.push_back( lit );            
+            assumptions.push_back( getCheckerLiteral( lit ) );
         }
         else
         {
@@ -151,7 +163,7 @@ ReductBasedCheck::iterationInternalLiterals(
             unfoundedSetCandidates.push_back( lit );
             if( !hasToAddClause )
                 continue;
-            hasToAddClause = addLiteralInClause( lit, clause );
+            hasToAddClause = addLiteralInClause( getCheckerLiteral( lit ), clause );
         }
     }
     
@@ -192,8 +204,11 @@ ReductBasedCheck::iterationExternalLiterals(
         assert( getCheckerVarFromExternalLiteral( lit ) != UINT_MAX );
         if( solver.getDecisionLevel( lit ) > 0 || solver.isUndefined( lit ) )
         {
-            trace_msg( modelchecker, 4, "Adding assumption " << Literal( getCheckerVarFromExternalLiteral( lit ), solver.isTrue( lit ) ? POSITIVE : NEGATIVE ) );
-            assumptions.push_back( Literal( getCheckerVarFromExternalLiteral( lit ), solver.isTrue( lit ) ? POSITIVE : NEGATIVE ) );
+            //During partial checks the undefined literals of the component are assumed true:
+            //the rules with a negative literal on them become a possible reason.
+            bool isTrue = solver.isTrue( lit ) || ( solver.isUndefined( lit ) && sameComponent( lit.getVariable() ) );
+            trace_msg( modelchecker, 4, "Adding assumption " << Literal( getCheckerVarFromExternalLiteral( lit ), isTrue ? POSITIVE : NEGATIVE ) );
+            assumptions.push_back( Literal( getCheckerVarFromExternalLiteral( lit ), isTrue ? POSITIVE : NEGATIVE ) );
             j++;
         }
         else
@@ -220,32 +235,23 @@ ReductBasedCheck::addClauseToChecker(
         if( !sameComponent( v ) )
         {
             Var newVar = getCheckerVarFromExternalLiteral( orig[ i ] );            
-            if( newVar != v )
-            {
-                orig[ i ].setVariable( newVar );
-                orig[ i ].setPositive();
-            }
+            orig[ i ].setVariable( newVar );
+            orig[ i ].setPositive();
         }
         else
         {
             if( orig[ i ].isNegativeBodyLiteral() )
             {
-                Var newVar = getCheckerVarFromExternalLiteral( orig[ i ] );
-                if( newVar != v )
-                {
-                    orig[ i ].setVariable( newVar );
-                    orig[ i ].setPositive();
-                }
+                orig[ i ].setVariable( getCheckerVarFromExternalLiteral( orig[ i ] ) );
+                orig[ i ].setPositive();
             }
             else if( orig[ i ].isDoubleNegatedBodyLiteral() )
             {
-                Var newVar = getCheckerVarFromExternalLiteral( orig[ i ] );
-                if( newVar != v )
-                {
-                    orig[ i ].setVariable( newVar );
-                    orig[ i ].setNegative();
-                }
+                orig[ i ].setVariable( getCheckerVarFromExternalLiteral( orig[ i ] ) );
+                orig[ i ].setNegative();
             }
+            else
+                orig[ i ].setVariable( getCheckerTrueVar( v ) );
         }
     }
     trace_msg( modelchecker, 2, "Adding clause " << *c );    
@@ -270,7 +276,7 @@ ReductBasedCheck::createInitialClauseAndSimplifyHCVars()
             removedHCVars++;
             trace_msg( modelchecker, 2, "Variable " << Literal( v ) << " is true at level 0: removed" );
             if( !satisfied )
-                satisfied = !addLiteralInClause( lit, clause );
+                satisfied = !addLiteralInClause( getCheckerLiteral( lit ), clause );
         }
         else
             j++;
@@ -310,12 +316,7 @@ ReductBasedCheck::initDataStructures()
 {
     trace_msg( modelchecker, 2, "First call. Removing unused variables" );
     for( unsigned i = 1; i < inUnfoundedSet.size(); ++i )
-    {
-        if( inUnfoundedSet[ i ] == 0 )
-            checker.addClause( Literal( i, POSITIVE ) );
-        else
-            inUnfoundedSet[ i ] = 0;        
-    }
+        inUnfoundedSet[ i ] = 0;
     #ifndef NDEBUG
     bool result = 
     #endif    
@@ -340,7 +341,7 @@ void ReductBasedCheck::checkModel(
     {
         trace_msg( modelchecker, 1, "SATISFIABLE: the model is not stable." );
         for( unsigned int i = 0; i < unfoundedSetCandidates.size(); i++ )
-            if( checker.isTrue( unfoundedSetCandidates[ i ] ) )
+            if( checker.isTrue( getCheckerLiteral( unfoundedSetCandidates[ i ] ) ) )
                 setInUnfoundedSet( unfoundedSetCandidates[ i ].getVariable() );            
         trace_action( modelchecker, 2, { printVector( unfoundedSet, "Unfounded set" ); } );
         statistics( &checker, foundUS( trail.size() != ( hcVariables.size() + externalLiterals.size() ), unfoundedSet.size() ) );
@@ -361,6 +362,7 @@ void ReductBasedCheck::addHCVariableProtected(
     Var v )
 {
     inUnfoundedSet[ v ] |= 4;
+    addCheckerTrueVar( v );
     numberOfInternalVariables++;
     attachLiterals( Literal( v, POSITIVE ) );
     solver.setComponent( v, NULL );
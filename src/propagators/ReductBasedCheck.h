@@ -23,6 +23,7 @@
 #include "../util/WaspAssert.h"
 #include "../stl/Vector.h"
 #include "HCComponent.h"
+#include "PartialCheckScheduler.h"
 #include "../Literal.h"
 #include "../input/Rule.h"
 using namespace std;
@@ -64,6 +65,7 @@ class ReductBasedCheck : public HCComponent
         vector< Literal > externalLiterals;
         
         vector< Var > generatorToCheckerId;
+        vector< Var > generatorToCheckerTrueId;
         
         unsigned int numberOfAtoms;        
         
@@ -75,6 +77,8 @@ class ReductBasedCheck : public HCComponent
         unsigned int removedHCVars;
         
         Literal literalToAdd;
+
+        PartialCheckScheduler partialChecks;
         
         void testModel();
         void computeAssumptions( vector< Literal >& assumptions );
@@ -86,10 +90,23 @@ class ReductBasedCheck : public HCComponent
             if( l.isNegative() || sameComponent( l.getVariable() ) )
                 return generatorToCheckerId[ l.getVariable() ];
             else            
-                return l.getVariable();            
-//            return l.isPositive() ? l.getVariable() : generatorToCheckerId[ l.getVariable() ]; 
+                return getCheckerTrueVar( l.getVariable() );
+        }
+        inline Var getCheckerTrueVar( Var v ) const
+        {
+            assert( v < generatorToCheckerTrueId.size() );
+            assert( generatorToCheckerTrueId[ v ] != UINT_MAX );
+            return generatorToCheckerTrueId[ v ];
+        }
+        inline Literal getCheckerLiteral( Literal l ) const { return Literal( getCheckerTrueVar( l.getVariable() ), l.getSign() ); }
+        inline void addCheckerTrueVar( Var v )
+        {
+            assert( v < generatorToCheckerTrueId.size() );
+            if( generatorToCheckerTrueId[ v ] != UINT_MAX )
+                return;
+            checker.addVariable();
+            generatorToCheckerTrueId[ v ] = checker.numberOfVariables();
         }
-        inline Var getCheckerTrueVar( Var v ) const { return v; }
         inline Var getCheckerFalseVar( Var v ) const
         {
             assert( v < generatorToCheckerId.size() );
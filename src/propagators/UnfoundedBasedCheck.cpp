@@ -9,14 +9,14 @@ UnfoundedBasedCheck::UnfoundedBasedCheck(
     Solver& s,
     unsigned numberOfInputAtoms ) : HCComponent( gusData_, s )
 {   
-    varsAtLevelZero = 0; numberOfAttachedVars = 0; inUnfoundedSet.push_back( 0 );
-    while( checker.numberOfVariables() < numberOfInputAtoms )
+    varsAtLevelZero = 0; numberOfAttachedVars = 0; inUnfoundedSet.push_back( 0 ); generatorToCheckerId.push_back( UINT_MAX );
+    //The checker contains only the variables of the atoms occurring in the component.
+    for( unsigned int i = 0; i < numberOfInputAtoms; i++ )
     {
-        checker.addVariable();
         inUnfoundedSet.push_back( 0 );
+        generatorToCheckerId.push_back( UINT_MAX );
     }
-    assert_msg( checker.numberOfVariables() == numberOfInputAtoms, checker.numberOfVariables() << " != " << numberOfInputAtoms );
-    assert( checker.numberOfVariables() == inUnfoundedSet.size() - 1 );
+    assert( numberOfInputAtoms == inUnfoundedSet.size() - 1 );
     
     initChecker();
 }
@@ -90,10 +90,10 @@ UnfoundedBasedCheck::iterationInternalLiterals(
             continue;
         
         if( solver.isTrue( v ) )
-            assumptions.push_back( Literal( v, POSITIVE ) );
+            assumptions.push_back( Literal( getCheckerVar( v ), POSITIVE ) );
         else if( solver.isFalse( v ) )
         {
-            assumptions.push_back( Literal( v, NEGATIVE ) );
+            assumptions.push_back( Literal( getCheckerVar( v ), NEGATIVE ) );
             assumptions.push_back( Literal( getGUSData( v ).unfoundedVarForHCC, NEGATIVE ) );
         }
     }
@@ -116,12 +116,12 @@ UnfoundedBasedCheck::iterationExternalLiterals(
 
         if( solver.getDecisionLevel( v ) > 0 )
         {
-            assumptions.push_back( Literal( v, solver.isTrue( v ) ? POSITIVE : NEGATIVE ) );
+            assumptions.push_back( Literal( getCheckerVar( v ), solver.isTrue( v ) ? POSITIVE : NEGATIVE ) );
             j++;
         }
         else
         {
-            isConflictual = !checker.addClauseRuntime( Literal( v, solver.isTrue( v ) ? POSITIVE : NEGATIVE ) );
+            isConflictual = !checker.addClauseRuntime( Literal( getCheckerVar( v ), solver.isTrue( v ) ? POSITIVE : NEGATIVE ) );
             if( isConflictual )
                 return;
         }
@@ -148,11 +148,11 @@ UnfoundedBasedCheck::addClausesForHCAtoms()
         Clause* c = new Clause( 3 );
         c->addLiteral( Literal( uv, POSITIVE ) );
         c->addLiteral( Literal( hv, POSITIVE ) );
-        c->addLiteral( Literal( v, NEGATIVE ) );
+        c->addLiteral( Literal( getCheckerVar( v ), NEGATIVE ) );
         
         isConflictual = 
             !checker.addClause( Literal( uv, NEGATIVE ), Literal( hv, NEGATIVE ) )
-        ||  !checker.addClause( Literal( v, POSITIVE ), Literal( hv, NEGATIVE ) )
+        ||  !checker.addClause( Literal( getCheckerVar( v ), POSITIVE ), Literal( hv, NEGATIVE ) )
         ||  !checker.addClause( c );        
         
         trace_msg( modelchecker, 2, "Adding clause: " << *c );
@@ -167,10 +167,10 @@ UnfoundedBasedCheck::addClausesForHCAtoms()
         if( !solver.isUndefined( v ) && solver.getDecisionLevel( v ) == 0 )
         {
             if( solver.isTrue( v ) )
-                isConflictual = !checker.addClause( Literal( v, POSITIVE ) );
+                isConflictual = !checker.addClause( Literal( getCheckerVar( v ), POSITIVE ) );
             else
             {
-                isConflictual = !checker.addClause( Literal( v, NEGATIVE ) )
+                isConflictual = !checker.addClause( Literal( getCheckerVar( v ), NEGATIVE ) )
                 || !checker.addClause( Literal( getGUSData( v ).unfoundedVarForHCC, NEGATIVE ) );
             }
             if( isConflictual )
@@ -270,7 +270,7 @@ UnfoundedBasedCheck::processRule(
         
         //body literal with opposite polarity
         if( !lit.isHeadAtom() || !sameComponent( v ) )
-            c->addLiteral( lit );
+            c->addLiteral( Literal( getCheckerVar( v ), lit.getSign() ) );
     }
     
     clause->removeDuplicates();    
@@ -278,7 +278,7 @@ UnfoundedBasedCheck::processRule(
     assert( headAtoms.size() > 0 );
     if( headAtoms.size() == 1 )
     {
-        c->addLiteral( Literal( headAtoms[ 0 ], NEGATIVE ) );
+        c->addLiteral( Literal( getCheckerVar( headAtoms[ 0 ] ), NEGATIVE ) );
         getGUSData( headAtoms[ 0 ] ).definingRulesForNonHCFAtom.push_back( clause );
         Literal defLit = solver.getLiteral( rule->getBodyAux() );
         if( defLit.getVariable() != 0 )
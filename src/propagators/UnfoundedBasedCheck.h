@@ -46,6 +46,7 @@ class UnfoundedBasedCheck : public HCComponent
         inline void addHCVariableProtected( Var v );
         vector< Var > hcVariablesNotTrueAtLevelZero;
         vector< Var > externalVars;
+        vector< Var > generatorToCheckerId;
 
         unsigned int varsAtLevelZero;        
         unsigned int numberOfAttachedVars;
@@ -66,6 +67,8 @@ class UnfoundedBasedCheck : public HCComponent
         
         inline bool addLiteralInClause( Literal lit, Clause* clause );
         inline void addExternalVariable( Var v );
+        inline Var addCheckerVar( Var v );
+        inline Var getCheckerVar( Var v ) const { assert( v < generatorToCheckerId.size() && generatorToCheckerId[ v ] != UINT_MAX ); return generatorToCheckerId[ v ]; }
         
         #ifdef TRACE_ON
         template< class T >
@@ -124,12 +127,13 @@ UnfoundedBasedCheck::addHCVariableProtected(
     solver.setComponent( v, NULL );
     solver.setHCComponent( v, this );
     
+    addCheckerVar( v );
     checker.addVariable();    
     getGUSData( v ).unfoundedVarForHCC = checker.numberOfVariables();
     checker.addVariable();
     getGUSData( v ).headVarForHCC = checker.numberOfVariables();  
     
-    trace_msg( modelchecker, 1, "Adding variable: " << Literal( v, POSITIVE ) << " with id: " << v 
+    trace_msg( modelchecker, 1, "Adding variable: " << Literal( v, POSITIVE ) << " with id: " << getCheckerVar( v )
             << " - u" << Literal( v, POSITIVE ) << " with id: " << getGUSData( v ).unfoundedVarForHCC
             << " - h" << Literal( v, POSITIVE ) << " with id: " << getGUSData( v ).headVarForHCC );
 //    #ifdef TRACE_ON
@@ -153,12 +157,23 @@ void
 UnfoundedBasedCheck::addExternalVariable(
     Var v )
 {
-    //TODO: FIX ME with a smarter strategy!
-    if( find( externalVars.begin(), externalVars.end(), v ) != externalVars.end() )
+    assert( !sameComponent( v ) );
+    if( generatorToCheckerId[ v ] != UINT_MAX )
         return;
     
+    addCheckerVar( v );
     externalVars.push_back( v );
     attachVar( v );
 }
 
+Var
+UnfoundedBasedCheck::addCheckerVar(
+    Var v )
+{
+    assert( v < generatorToCheckerId.size() && generatorToCheckerId[ v ] == UINT_MAX );
+    checker.addVariable();
+    generatorToCheckerId[ v ] = checker.numberOfVariables();
+    return generatorToCheckerId[ v ];
+}
+
 #endif
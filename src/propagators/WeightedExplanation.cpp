@@ -0,0 +1,68 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#include "WeightedExplanation.h"
+#include "../util/WaspAssert.h"
+
+#include <algorithm>
+
+bool
+WeightedExplanation::heavierFirst(
+    const Candidate& c1,
+    const Candidate& c2 )
+{
+    if( c1.weight != c2.weight )
+        return c1.weight > c2.weight;
+    return c1.level < c2.level;
+}
+
+void
+WeightedExplanation::reduce(
+    int64_t requiredWeight )
+{
+    if( requiredWeight <= 0 )
+    {
+        candidates.clear();
+        return;
+    }
+
+    //If the lightest candidate is needed all of them are needed.
+    int64_t weight = 0;
+    uint64_t minWeight = UINT64_MAX;
+    for( unsigned int i = 0; i < candidates.size(); i++ )
+    {
+        weight += candidates[ i ].weight;
+        if( candidates[ i ].weight < minWeight )
+            minWeight = candidates[ i ].weight;
+    }
+    assert_msg( weight >= requiredWeight, "The candidates do not reach the required weight " << requiredWeight );
+    if( candidates.empty() || weight - ( int64_t ) minWeight < requiredWeight )
+        return;
+
+    std::sort( candidates.begin(), candidates.end(), heavierFirst );
+    weight = 0;
+    for( unsigned int i = 0; i < candidates.size(); i++ )
+    {
+        weight += candidates[ i ].weight;
+        if( weight >= requiredWeight )
+        {
+            candidates.erase( candidates.begin() + i + 1, candidates.end() );
+            return;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+*
+*  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*/
+
+#ifndef WASP_WEIGHTEDEXPLANATION_H
+#define WASP_WEIGHTEDEXPLANATION_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../Literal.h"
+using namespace std;
+
+/**
+ * The explanation of a literal inferred by a weighted constraint.
+ * The candidates are the literals of the constraint that are assigned before
+ * the inferred one: reduce keeps the heaviest of them, preferring the lowest
+ * decision levels among the ones with the same weight, until their weight
+ * reaches the weight required by the inference.
+ */
+class WeightedExplanation
+{
+    public:
+        inline WeightedExplanation() {}
+
+        inline void clear() { candidates.clear(); }
+        inline void addCandidate( Literal lit, uint64_t weight, unsigned int level ) { candidates.push_back( Candidate( lit, weight, level ) ); }
+
+        /**
+         * If the candidates do not reach the required weight all of them are kept.
+         */
+        void reduce( int64_t requiredWeight );
+
+        inline unsigned int size() const { return candidates.size(); }
+        inline Literal operator[]( unsigned int i ) const { assert( i < candidates.size() ); return candidates[ i ].lit; }
+
+    private:
+        inline WeightedExplanation( const WeightedExplanation& );
+
+        struct Candidate
+        {
+            inline Candidate( Literal l, uint64_t w, unsigned int dl ) : lit( l ), weight( w ), level( dl ) {}
+            Literal lit;
+            uint64_t weight;
+            unsigned int level;
+        };
+
+        static bool heavierFirst( const Candidate& c1, const Candidate& c2 );
+
+        vector< Candidate > candidates;
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef WASP_FROZENLISTS_H
+#define WASP_FROZENLISTS_H
+
+#include <cassert>
+#include "Vector.h"
+using namespace std;
+
+/**
+ * A list of elements for each key, stored in a single array (CSR format).
+ * Elements are added as pairs (key, element) and freeze groups them by key,
+ * keeping the order of insertion. After freeze the lists cannot be modified.
+ */
+template< class T >
+class FrozenLists
+{
+    public:
+        inline FrozenLists() : frozen( false ) {}
+
+        inline void add( unsigned int key, T element ) { assert( !frozen ); keys.push_back( key ); elements.push_back( element ); }
+
+        /**
+         * Groups the elements by key. Keys must be smaller than numberOfKeys.
+         */
+        void freeze( unsigned int numberOfKeys );
+        inline bool isFrozen() const { return frozen; }
+
+        inline unsigned int size( unsigned int key ) const { assert( frozen || elements.empty() ); return key + 1 < offsets.size() ? offsets[ key + 1 ] - offsets[ key ] : 0; }
+        inline const T& get( unsigned int key, unsigned int i ) const { assert( i < size( key ) ); return elements[ offsets[ key ] + i ]; }
+
+    private:
+        Vector< unsigned int > offsets;
+        Vector< T > elements;
+        Vector< unsigned int > keys;
+        bool frozen;
+
+        FrozenLists( const FrozenLists< T >& );
+        FrozenLists< T >& operator=( const FrozenLists< T >& );
+};
+
+template< class T >
+void
+FrozenLists< T >::freeze(
+    unsigned int numberOfKeys )
+{
+    assert( !frozen );
+    frozen = true;
+    offsets.reserve( numberOfKeys + 1 );
+    for( unsigned int i = 0; i <= numberOfKeys; i++ )
+        offsets.push_back( 0 );
+    for( unsigned int i = 0; i < keys.size(); i++ )
+    {
+        assert( keys[ i ] < numberOfKeys );
+        offsets[ keys[ i ] + 1 ]++;
+    }
+    for( unsigned int i = 1; i <= numberOfKeys; i++ )
+        offsets[ i ] += offsets[ i - 1 ];
+
+    //Counting sort: next[ k ] is the first free position of key k.
+    Vector< unsigned int > next;
+    next.reserve( numberOfKeys );
+    for( unsigned int i = 0; i < numberOfKeys; i++ )
+        next.push_back( offsets[ i ] );
+
+    Vector< T > sorted;
+    sorted.reserve( elements.size() );
+    for( unsigned int i = 0; i < elements.size(); i++ )
+        sorted.push_back( elements[ i ] );
+    for( unsigned int i = 0; i < elements.size(); i++ )
+        sorted[ next[ keys[ i ] ]++ ] = elements[ i ];
+
+    elements.swap( sorted );
+    keys.clearAndDelete();
+}
+
+#endif
@@ -19,6 +19,7 @@
 #ifndef WASP_ISTREAM_H
 #define WASP_ISTREAM_H
 
+#include <cassert>
 #include <iostream>
 
 using namespace std;
@@ -28,6 +29,7 @@ class Istream
     public:
         explicit inline Istream( istream& in_ ) : in( in_ ), idx( 0 ) { buff[ 0 ] = '\0';  in.read( buff, 2047 ); buff[ in.gcount() ] = '\0'; }
         inline char next();
+        inline char previous() const { assert( idx > 0 ); return buff[ idx - 1 ]; }
         inline bool read( unsigned int& value );
         inline bool read( uint64_t& value );
         inline bool read( int& value );
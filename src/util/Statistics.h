@@ -22,8 +22,11 @@
 #include <cassert>
 #include <string>
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <unordered_map>
+#include <sys/resource.h>
+#include <sys/time.h>
 using namespace std;
 
 class Solver;
@@ -34,6 +37,17 @@ class Solver;
 
 #define statistics( solver, METHOD ) Statistics::inst( solver ).METHOD
 
+struct StageStatistics
+{
+    string name;
+    double time;
+    long peakMemoryIncrease;
+    unsigned int variablesIn;
+    unsigned int variablesOut;
+    unsigned int clausesIn;
+    unsigned int clausesOut;
+};
+
 class Statistics {    
 
     public:            
@@ -59,9 +73,12 @@ class Statistics {
         disabled( false ), generator( true ), numberOfUS( 0 ), maxSizeUS( 0 ), minSizeUS( MAXUNSIGNEDINT ), avgUS( 0 ),
         numberOfUCCandidates( 0 ), maxSizeUCCandidates( 0 ), minSizeUCCandidates( MAXUNSIGNEDINT ), avgUCCandidates( 0 ), numberOfAssums( 0 ), maxAssums( 0 ), 
         minAssums( MAXUNSIGNEDINT ), avgAssums( 0 ), numberOfCalling( 0 ), minTime( MAXUNSIGNEDINT ), 
-        maxTime( 0 ), avgTime( 0 ), currentTime( 0 ), numberOfPartialChecks( 0 ), partialCheckWithUS( 0 ),
+        maxTime( 0 ), avgTime( 0 ), currentTime( 0 ), numberOfPartialChecks( 0 ), partialCheckWithUS( 0 ), skippedPartialChecks( 0 ),
+        externalPartialChecks( 0 ), externalPartialChecksWithConflict( 0 ), skippedExternalPartialChecks( 0 ),
         clausesAfterSimplifications( 0 ), variablesAfterSimplifications( 0 ), numberOfVars( 0 ), trueAtLevelZero( 0 ),
-        numberOfSolverCalls( 0 ), numberOfMultiAggregates( 0 ), sumOfBoundsMultiAggregates( 0 )
+        numberOfSolverCalls( 0 ), numberOfMultiAggregates( 0 ), sumOfBoundsMultiAggregates( 0 ),
+        numberOfEncodedAggregates( 0 ), numberOfEncodingVariables( 0 ),
+        numberOfLearnedPseudoBooleanConstraints( 0 ), sumOfSizeLearnedPseudoBooleanConstraints( 0 )
         {
         }
 
@@ -113,6 +130,12 @@ class Statistics {
                 numberOfLearnedTernaryClausesFromPropagators++;
         }            
 
+        inline void onLearningPseudoBooleanConstraint( unsigned int size )
+        {
+            numberOfLearnedPseudoBooleanConstraints++;
+            sumOfSizeLearnedPseudoBooleanConstraints += size;
+        }
+
         inline void startShrinkingLearnedClause( unsigned int size ) { shrink = size; max_literals += size; }
         inline void endShrinkingLearnedClause( unsigned int size )
         {
@@ -161,14 +184,23 @@ class Statistics {
             sumOfBoundsMultiAggregates += nbOfBounds;        
         }
 
+        inline void onEncodingAggregate( unsigned int nbOfVariables )
+        {
+            numberOfEncodedAggregates++;
+            numberOfEncodingVariables += nbOfVariables;
+        }
+
         inline void afterPreprocessing( unsigned int vars, unsigned int clauses )
         {
             clausesAfterSimplifications = clauses;
             variablesAfterSimplifications = vars;                
+            if( !disabled && generator && !wasp::Options::stageStatistics.empty() )
+                dumpStages( wasp::Options::stageStatistics );
             if( disabled || !wasp::Options::stats )
                 return;
 
             if(sateliteTime!=0) sateliteTime=time(0)-sateliteTime;
+            printStages();
             if( wasp::Options::statsVerbosity >= 1 )
             {
             cerr << endl << "After satelite" << endl;
@@ -231,6 +263,8 @@ class Statistics {
             cerr << "      Left after propagation    : " << clauses << endl;
             cerr << "    MultiAggregates             : " << numberOfMultiAggregates << endl;
             cerr << "      Replaced aggregates       : " << numberOfMultiAggregates * sumOfBoundsMultiAggregates << endl;
+            cerr << "    Aggregates as clauses       : " << numberOfEncodedAggregates << endl;
+            cerr << "      Auxiliary variables       : " << numberOfEncodingVariables << endl;
             
             cerr << "    Variables                   : " << vars << endl;
             cerr << "      Assigned                  : " << assignedVars << " (" << ( ( double ) assignedVars * 100 / ( double ) numberOfVars ) << "%)" << endl;
@@ -277,10 +311,38 @@ class Statistics {
                     cerr << "...end parsing" << endl;
             } 
         }
-        inline void startSCCs() {}
-        inline void endSCCs() {}
-        inline void startCompletion() {}
-        inline void endCompletion() {}
+
+        /**
+         * Preprocessing is made of named stages: for each of them the wall
+         * time, the increase of the peak memory and the unassigned variables
+         * and clauses before and after are recorded.
+         */
+        inline void startStage( const char* name, unsigned int vars, unsigned int clauses )
+        {
+            if( disabled )
+                return;
+            StageStatistics stage;
+            stage.name = name;
+            stage.time = currentSeconds();
+            stage.peakMemoryIncrease = peakMemory();
+            stage.variablesIn = vars;
+            stage.clausesIn = clauses;
+            stage.variablesOut = vars;
+            stage.clausesOut = clauses;
+            stages.push_back( stage );
+        }
+
+        inline void endStage( unsigned int vars, unsigned int clauses )
+        {
+            if( disabled )
+                return;
+            assert( !stages.empty() );
+            StageStatistics& stage = stages.back();
+            stage.time = currentSeconds() - stage.time;
+            stage.peakMemoryIncrease = peakMemory() - stage.peakMemoryIncrease;
+            stage.variablesOut = vars;
+            stage.clausesOut = clauses;
+        }
 
         inline void setChecker() { generator = false; }                        
 
@@ -304,6 +366,17 @@ class Statistics {
                 maxTime = c;
         }
 
+        inline void skipPartialCheck() { skippedPartialChecks++; }
+
+        inline void onExternalPartialCheck( bool foundConflict )
+        {
+            externalPartialChecks++;
+            if( foundConflict )
+                externalPartialChecksWithConflict++;
+        }
+
+        inline void skipExternalPartialCheck() { skippedExternalPartialChecks++; }
+
         inline void foundUS( bool isPartial, unsigned int size )
         {
             if( isPartial )
@@ -456,6 +529,10 @@ class Statistics {
         
         unsigned int numberOfPartialChecks;
         unsigned int partialCheckWithUS;
+        unsigned int skippedPartialChecks;
+        unsigned int externalPartialChecks;
+        unsigned int externalPartialChecksWithConflict;
+        unsigned int skippedExternalPartialChecks;
         unsigned int clausesAfterSimplifications;
         unsigned int variablesAfterSimplifications;
         unsigned int numberOfVars;
@@ -467,6 +544,58 @@ class Statistics {
         unsigned int numberOfMultiAggregates;
         unsigned int sumOfBoundsMultiAggregates;
 
+        unsigned int numberOfEncodedAggregates;
+        unsigned int numberOfEncodingVariables;
+
+        unsigned int numberOfLearnedPseudoBooleanConstraints;
+        uint64_t sumOfSizeLearnedPseudoBooleanConstraints;
+
+        vector< StageStatistics > stages;
+
+        static double currentSeconds()
+        {
+            struct timeval t;
+            gettimeofday( &t, NULL );
+            return t.tv_sec + t.tv_usec / 1000000.0;
+        }
+
+        //Peak resident set size in kilobytes.
+        static long peakMemory()
+        {
+            struct rusage usage;
+            getrusage( RUSAGE_SELF, &usage );
+            return usage.ru_maxrss;
+        }
+
+        void printStages()
+        {
+            if( stages.empty() )
+                return;
+            cerr << "Preprocessing stages" << endl << endl;
+            for( unsigned int i = 0; i < stages.size(); i++ )
+            {
+                const StageStatistics& stage = stages[ i ];
+                cerr << "    " << stage.name << string( stage.name.size() < 28 ? 28 - stage.name.size() : 1, ' ' ) << ": " << stage.time << " s, +" << stage.peakMemoryIncrease << " KB, variables " << stage.variablesIn << " -> " << stage.variablesOut << ", clauses " << stage.clausesIn << " -> " << stage.clausesOut << endl;
+            }
+            cerr << separator << endl;
+        }
+
+        void dumpStages( const string& filename )
+        {
+            ofstream out( filename.c_str() );
+            if( !out.good() )
+                WaspErrorMessage::errorGeneric( "Cannot write the statistics of the stages to " + filename + "." );
+            out << "[" << endl;
+            for( unsigned int i = 0; i < stages.size(); i++ )
+            {
+                const StageStatistics& stage = stages[ i ];
+                out << "  { \"stage\": \"" << stage.name << "\", \"time\": " << stage.time << ", \"peak_rss_increase_kb\": " << stage.peakMemoryIncrease
+                    << ", \"variables_in\": " << stage.variablesIn << ", \"variables_out\": " << stage.variablesOut
+                    << ", \"clauses_in\": " << stage.clausesIn << ", \"clauses_out\": " << stage.clausesOut << " }" << ( i + 1 < stages.size() ? "," : "" ) << endl;
+            }
+            out << "]" << endl;
+        }
+
         void printStatistics()
         {
             if( disabled || !wasp::Options::stats )
@@ -497,6 +626,13 @@ class Statistics {
             cerr << endl;
             }
             
+            if( numberOfLearnedPseudoBooleanConstraints > 0 )
+            {
+            cerr << "    Learned PB constraints      : " << numberOfLearnedPseudoBooleanConstraints << endl;
+            cerr << "      AVG Size                  : " << ( ( double ) sumOfSizeLearnedPseudoBooleanConstraints / ( double ) numberOfLearnedPseudoBooleanConstraints ) << endl;
+            cerr << endl;
+            }
+
             cerr << "    Deletion calls              : " << numberOfDeletionInvocation << endl;
             if( numberOfDeletionInvocation > 0 && wasp::Options::statsVerbosity >= 1 )
             {
@@ -513,6 +649,12 @@ class Statistics {
             cerr << "    Shrinked clauses            : " << shrinkedClauses << " (" << ( ( double ) shrinkedClauses * 100 / ( double ) numberOfLearnedClauses ) << "%)" << endl;
             cerr << "    Shrinked literals           : " << shrinkedLiterals << " (" << ( ( double ) shrinkedLiterals * 100 / ( double ) sumOfSizeLearnedClauses ) << "%)" << endl;
             cerr << "    Conflict literals           : " << tot_literals <<  " (deleted " << ( ( max_literals - tot_literals ) * 100 / ( double ) max_literals ) << "%)" << endl; 
+            if( externalPartialChecks + skippedExternalPartialChecks > 0 )
+            {
+            cerr << "    External partial checks     : " << externalPartialChecks << endl;
+            cerr << "      With conflict             : " << externalPartialChecksWithConflict << endl;
+            cerr << "      Skipped                   : " << skippedExternalPartialChecks << endl;
+            }
             cerr << endl;                                        
         }                
 
@@ -548,6 +690,7 @@ class Statistics {
             cerr << "      Avg Time                  : " << ( numberOfCalling == 0 ? -1 : avgTime / numberOfCalling ) << " s" << endl;                
             cerr << "      Partial checks            : " << numberOfPartialChecks << " (" << ( numberOfCalling == 0 ? -1 : ( ( double ) numberOfPartialChecks / ( double ) numberOfCalling ) * 100 ) << "% of total)" << endl;
             cerr << "        Found USs               : " << partialCheckWithUS << " (" << ( numberOfPartialChecks == 0 ? -1 : ( ( double ) partialCheckWithUS / ( double ) numberOfPartialChecks ) * 100 ) << "% of total)" << endl;
+            cerr << "      Skipped partial checks    : " << skippedPartialChecks << endl;
             cerr << endl;
             cerr << "    Unfounded sets                " << endl;
             cerr << "      Min Size                  : " << minSizeUS << endl;
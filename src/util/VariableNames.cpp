@@ -18,68 +18,86 @@
 
 #include "VariableNames.h"
 #include "WaspAssert.h"
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 using namespace std;
-vector< string > VariableNames::variables;
-bool VariableNames::toBePrinted = false;
+
+#define NO_NAME SIZE_MAX
+
+vector< char > VariableNames::names;
+vector< size_t > VariableNames::offsets;
+vector< bool > VariableNames::visible;
+vector< bool > VariableNames::toBePrinted;
 
 bool
 VariableNames::isHidden(
     Var v )
 {
-    //assert_msg( v < variables.size(), "Var " << v << " is out of index: " << variables.size() );
-    if( v >= variables.size() )
+    if( v >= visible.size() )
         return true;
-    return variables[ v ] == "";
+    return !visible[ v ];
 }
 
-const string&
+const char*
 VariableNames::getName(
     Var v )
 {
+    bool hasName = v < offsets.size() && offsets[ v ] != NO_NAME;
     #ifdef TRACE_ON
-    if( isHidden( v ) )
+    if( !hasName )
     {
+        //Hidden variables are printed by id: use a small ring of buffers, so
+        //that several names can be used in the same trace message.
+        static string traceNames[ 8 ];
+        static unsigned int next = 0;
         stringstream s;
         s << v;
-        variables[ v ] = s.str();
+        string& name = traceNames[ next++ % 8 ];
+        name = s.str();
+        return name.c_str();
     }
     #endif
     assert( !isHidden( v ) );
-    return variables[ v ];
+    if( !hasName )
+        return "";
+    return &names[ offsets[ v ] ];
 }
 
 void
 VariableNames::setName(
     Var v,
-    string name )
+    const char* name )
 {
-    assert_msg( v < variables.size(), "Access element " << v << " in a vector of size " << variables.size() << "." );
-    variables[ v ] = name;
+    assert_msg( v < visible.size(), "Access element " << v << " in a vector of size " << visible.size() << "." );
+    if( name[ 0 ] == '\0' )
+        return;
+
+    if( v >= offsets.size() )
+        offsets.resize( v + 1, NO_NAME );
+    offsets[ v ] = names.size();
+    names.insert( names.end(), name, name + strlen( name ) + 1 );
+    visible[ v ] = true;
 }
 
 void
 VariableNames::addVariable()
 {
-    variables.push_back( "" );
+    visible.push_back( false );
+    toBePrinted.push_back( false );
 }
 
 void
 VariableNames::setToBePrinted(
     Var v )
 {
-    variables[ v ] = "1";
+    visible[ v ] = true;
+    toBePrinted[ v ] = true;
 }
 
 bool
 VariableNames::hasToBePrinted(
     Var v )
 {
-    return variables[ v ] == "1";
+    return toBePrinted[ v ];
 }
-
-const vector< string >&
-VariableNames::getVariables()
-{
-    return variables;
-}
\ No newline at end of file
@@ -25,21 +25,26 @@
 #include "WaspConstants.h"
 using namespace std;
 
+/**
+ * Names are stored null-terminated in a single arena: only atoms that can be
+ * printed get an offset, auxiliary variables cost one bit each.
+ */
 class VariableNames
 {
     public:
 
         static bool isHidden( Var v );
-        static const string& getName( Var v );
-        static void setName( Var v, string name );
+        static const char* getName( Var v );
+        static void setName( Var v, const char* name );
         static void setToBePrinted( Var v );
         static bool hasToBePrinted( Var v );
         static void addVariable();
-        static const vector< string >& getVariables();
         
     private:
-        static vector< string > variables;
-        static bool toBePrinted;
+        static vector< char > names;
+        static vector< size_t > offsets;
+        static vector< bool > visible;
+        static vector< bool > toBePrinted;
 };
 
 #endif
@@ -180,12 +180,96 @@
 #define GRINGO_BPLUS "B+"
 #define GRINGO_BMINUS "B-"
 
+/*
+ * Aspif Format
+ */
+#define ASPIF_FIRST_CHAR 'a'
+#define ASPIF_HEADER "asp"
+#define ASPIF_END 0
+#define ASPIF_RULE 1
+#define ASPIF_MINIMIZE 2
+#define ASPIF_PROJECTION 3
+#define ASPIF_OUTPUT 4
+#define ASPIF_EXTERNAL 5
+#define ASPIF_ASSUMPTION 6
+#define ASPIF_HEURISTIC 7
+#define ASPIF_EDGE 8
+#define ASPIF_THEORY 9
+#define ASPIF_COMMENT 10
+#define ASPIF_DISJUNCTIVE_HEAD 0
+#define ASPIF_CHOICE_HEAD 1
+#define ASPIF_NORMAL_BODY 0
+#define ASPIF_WEIGHT_BODY 1
+#define ASPIF_EXTERNAL_FREE 0
+#define ASPIF_EXTERNAL_TRUE 1
+#define ASPIF_EXTERNAL_FALSE 2
+#define ASPIF_EXTERNAL_RELEASE 3
+
+/*
+ * Domain heuristic modifiers
+ */
+#define DOMAIN_HEURISTIC_LEVEL 0
+#define DOMAIN_HEURISTIC_SIGN 1
+#define DOMAIN_HEURISTIC_FACTOR 2
+#define DOMAIN_HEURISTIC_INIT 3
+#define DOMAIN_HEURISTIC_TRUE 4
+#define DOMAIN_HEURISTIC_FALSE 5
+
+/*
+ * Snapshot of the preprocessed program
+ */
+#define SNAPSHOT_MAGIC 0x50534157
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_BYTE_ORDER 0x01020304
+#define SNAPSHOT_HEADER_SIZE 5
+#define SNAPSHOT_FLAG_DIMACS 1
+#define SNAPSHOT_FLAG_MAXSAT 2
+#define SNAPSHOT_FLAG_INCOHERENT 4
+#define SNAPSHOT_NAMES 1
+#define SNAPSHOT_FROZEN 2
+#define SNAPSHOT_ELIMINATED 3
+#define SNAPSHOT_AGGREGATES 4
+#define SNAPSHOT_CARDINALITY_CONSTRAINTS 5
+#define SNAPSHOT_MULTI_AGGREGATES 6
+#define SNAPSHOT_DISJUNCTIONS 7
+#define SNAPSHOT_GUS_DATA 8
+#define SNAPSHOT_COMPONENTS 9
+#define SNAPSHOT_CLAUSES 10
+#define SNAPSHOT_BINARY_CLAUSES 11
+#define SNAPSHOT_OPTIMIZATION 12
+#define SNAPSHOT_HEURISTIC 13
+#define SNAPSHOT_UNITS 14
+#define SNAPSHOT_PSEUDO_BOOLEAN_CONSTRAINTS 15
+
+/*
+ * Encoding of aggregates
+ */
+#define AGGREGATES_ENCODING_AUTO 0
+#define AGGREGATES_ENCODING_PROPAGATOR 1
+#define AGGREGATES_ENCODING_CLAUSES 2
+#define AGGREGATES_ENCODING_MAX_NODES 100000
+#define AGGREGATES_ENCODING_AUTO_MAX_NODES 256
+#define AGGREGATES_ENCODING_AUTO_NODES_PER_LITERAL 4
+
+/*
+ * Cutting planes
+ */
+#define CUTTING_PLANES_MAX_COEFFICIENT 1000000000000ULL
+#define CUTTING_PLANES_MAX_LEARNED 1000
+#define CUTTING_PLANES_LEARNED_INCREMENT 1.1
+
+/*
+ * Partial checks
+ */
+#define PARTIAL_CHECKS_MAX_INTERVAL 1024
+
 /*
  * Interpreters
  */
 #define NO_INTERPRETER 0
 #define PYTHON_INTERPRETER 1
 #define PERL_INTERPRETER 2
+#define NATIVE_INTERPRETER 3
 
 /*
  * Init minisat heuristic
@@ -111,7 +111,6 @@ class WaspHelp
             cout << "--lbd-frozenclause                     - Keep clauses with LBD lower than this value [default: 30]" << endl;
             cout << "--lbd-minclause                        - Learned clauses with LBD lower than this value are minimized [default: 6]" << endl;                        
 
-            #if defined(ENABLE_PERL) || defined(ENABLE_PYTHON)
             cout << separator << endl;
             
             cout << "External scripts options                     " << endl << endl;
@@ -122,11 +121,11 @@ class WaspHelp
             #ifdef ENABLE_PYTHON
             cout << "       =python                         - Use python as interpreter" << endl;            
             #endif
+            cout << "       =native                         - Use shared libraries (see src/interpreters/WaspNativePlugin.h)" << endl;
             cout << "--heuristic-scriptname                 - Specify the name of the script" << endl;            
             cout << "--plugins-files=file1,file2,...,filen  - Specify a list of plugins" << endl;
-            cout << "--script-directory=absolutepath        - Specify a different folder for retrieving the python modules (default is .)" << endl;
+            cout << "--script-directory=absolutepath        - Specify a different folder for retrieving the python modules and the native plugins (default is .)" << endl;
             cout << "--lazy-weakconstraints                 - Enable the algorithm to lazily add weak constraints" << endl;
-            #endif
             cout << separator << endl;
 
             cout << "Model Checker options                  " << endl << endl;
@@ -136,6 +135,7 @@ class WaspHelp
             cout << "--modelchecker-compactreasons          - Enable a different strategy to compute reasons. (Note: it enables the option --disjunction=auto)" << endl;            
             cout << "--forward-partialchecks                - Enable forward partial checks" << endl;
             cout << "--heuristic-partialchecks              - Enable heuristic to activate or disactivate partial checks during the search" << endl;            
+            cout << "--adaptive-partialchecks               - Enable forward partial checks, skipping them more often while they do not find conflicts" << endl;
                 
             cout << separator << endl;
             cout << "Weak Constraints options               " << endl << endl;
@@ -209,6 +209,7 @@ class WaspHelp
             cout << separator << endl;
             cout << "General options                        " << endl << endl;
             cout << "--stats=verbosity                      - Print statistics (verbosity is optional 0=basic stats, 1=more stats, 2=dynamic stats)" << endl;
+            cout << "--stats-stages=<file>                  - Write time, memory and size of each preprocessing stage in file (JSON)" << endl;
             cout << "-n                                     - Specify the answers to compute" << endl;
             cout << "       <=0                             - To compute all answers" << endl;
             cout << "       =k                              - To compute at most k answers" << endl;
@@ -216,6 +217,14 @@ class WaspHelp
             cout << "--help                                 - Print this guide and exit" << endl;
             cout << "--disable-simplifications              - Disable the simplifications of satelite" << endl;
             cout << "--enable-multiaggregates               - Share aggregate sets if possible" << endl;
+            cout << "--enable-cutting-planes                - Learn pseudo-Boolean constraints from conflicts" << endl;
+            cout << "--recompute-components-on-restarts     - Remove the cyclic components that become acyclic at level 0 also on restarts" << endl;
+            cout << "--aggregates-encoding                  - Select how aggregates are handled" << endl;
+            cout << "       =auto                           - Use clauses for small aggregates and propagators for the others (default)" << endl;
+            cout << "       =propagator                     - Use propagators" << endl;
+            cout << "       =clauses                        - Use clauses unless the encoding is too large" << endl;
+            cout << "--dump-snapshot=<file>                 - Preprocess the input, save it in file and exit" << endl;
+            cout << "--load-snapshot=<file>                 - Read a preprocessed input from file instead of stdin" << endl;
             cout << "--enumeration-strategy                 - Select different strategy for enumeration of answer sets" << endl;
             cout << "       =bt                             - Use backtracking for enumeration" << endl;
             cout << "       =bt-reorder                     - Use backtracking for enumeration with reorder of assumptions" << endl;
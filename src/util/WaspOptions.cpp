@@ -113,6 +113,13 @@ namespace wasp
 #define OPTIONID_enumeration ( 'z' + 110 )
 #define OPTIONID_modelchecker_compactreasons ( 'z' + 111 )
 #define OPTIONID_multiaggregates ( 'z' + 112 ) 
+#define OPTIONID_dumpsnapshot ( 'z' + 113 )
+#define OPTIONID_loadsnapshot ( 'z' + 114 )
+#define OPTIONID_statsstages ( 'z' + 115 )
+#define OPTIONID_cuttingplanes ( 'z' + 116 )
+#define OPTIONID_aggregatesencoding ( 'z' + 117 )
+#define OPTIONID_recomputecomponents ( 'z' + 118 )
+#define OPTIONID_adaptive_partialchecks ( 'z' + 119 )
     
 /* WEAK CONSTRAINTS OPTIONS */
 #define OPTIONID_weakconstraintsalgorithm ( 'z' + 200 )
@@ -172,6 +179,8 @@ bool Options::forwardPartialChecks = false;
 
 bool Options::heuristicPartialChecks = false;
 
+bool Options::adaptivePartialChecks = false;
+
 WEAK_CONSTRAINTS_ALG Options::weakConstraintsAlg = ONE;
 
 unsigned int Options::kthreshold = 0;
@@ -193,10 +202,16 @@ vector< string > Options::pluginsFilenames;
 
 string Options::scriptDirectory = "";
 
+string Options::dumpSnapshot = "";
+string Options::loadSnapshot = "";
+
 unsigned int Options::predMinimizationAlgorithm = NO_PREDMINIMIZATION;
 vector< string > Options::predicatesToMinimize;
 
 bool Options::multiAggregates = false;
+bool Options::cuttingPlanes = false;
+bool Options::recomputeComponentsOnRestart = false;
+unsigned int Options::aggregatesEncoding = AGGREGATES_ENCODING_AUTO;
 bool Options::queryCoreCache = false;
 
 void split( const string &s, char delim, vector< string >& output )
@@ -220,6 +235,8 @@ map< string, unsigned int > Options::stringToInitMinisatHeuristic;
 
 map< string, unsigned int > Options::stringToPredMinimization;
 
+map< string, unsigned int > Options::stringToAggregatesEncoding;
+
 bool Options::simplifications = true;
 
 unsigned Options::silent = 0;
@@ -258,6 +275,7 @@ double Options::initVariableDecay = ( 1 / 0.95 );
 bool Options::stats = false;
 
 unsigned Options::statsVerbosity = 0;
+string Options::stageStatistics = "";
 
 unsigned int Options::initMinisatHeuristic = INIT_MINISAT_ALL_EQUALS;
 unsigned int Options::initValue = 0;
@@ -312,6 +330,7 @@ Options::parse(
                 { "printatomstable", no_argument, NULL, OPTIONID_printatomtable },
                 { "id-output", no_argument, NULL, OPTIONID_idOutput },
                 { "stats", optional_argument, NULL, OPTIONID_stats },
+                { "stats-stages", required_argument, NULL, OPTIONID_statsstages },
 
                 /* MINISAT POLICY */
                 { "minisat-policy", no_argument, NULL, OPTIONID_minisatheuristic },
@@ -326,14 +345,12 @@ Options::parse(
                 { "minimization-algorithm", required_argument, NULL, OPTIONID_predminimizationalgorithm },
                 { "min-chunk-percentage", required_argument, NULL, OPTIONID_predminimizationchunkpercentage },
                 
-                #if defined(ENABLE_PYTHON) || defined(ENABLE_PERL)
                 /* HEURISTIC */
                 { "interpreter", required_argument, NULL, OPTIONID_heuristic_interpreter },
                 { "heuristic-scriptname", required_argument, NULL, OPTIONID_heuristic_scriptname },
                 { "plugins-files", required_argument, NULL, OPTIONID_heuristic_plugins },
                 { "script-directory", required_argument, NULL, OPTIONID_heuristic_setscriptdirectory },
                 { "lazy-weakconstraints", no_argument, NULL, OPTIONID_heuristic_lazyweakconstraints },                
-                #endif
                 /* RESTART OPTIONS */                
 //                { "geometric-restarts", optional_argument, NULL, OPTIONID_geometric_restarts },
 //                { "minisat-restarts", optional_argument, NULL, OPTIONID_minisat_restarts },
@@ -361,11 +378,17 @@ Options::parse(
                 { "max-cost", required_argument, NULL, OPTIONID_max_cost },
                 { "disable-simplifications", no_argument, NULL, OPTIONID_simplifications },
                 { "enable-multiaggregates", no_argument, NULL, OPTIONID_multiaggregates },
+                { "enable-cutting-planes", no_argument, NULL, OPTIONID_cuttingplanes },
+                { "recompute-components-on-restarts", no_argument, NULL, OPTIONID_recomputecomponents },
+                { "aggregates-encoding", required_argument, NULL, OPTIONID_aggregatesencoding },
+                { "dump-snapshot", required_argument, NULL, OPTIONID_dumpsnapshot },
+                { "load-snapshot", required_argument, NULL, OPTIONID_loadsnapshot },
                 { "enumeration-strategy", required_argument, NULL, OPTIONID_enumeration },                
                 
                 { "modelchecker-algorithm", required_argument, NULL, OPTIONID_modelchecker_algorithm },  
                 { "forward-partialchecks", no_argument, NULL, OPTIONID_forward_partialchecks },  
                 { "heuristic-partialchecks", no_argument, NULL, OPTIONID_heuristic_partialchecks },
+                { "adaptive-partialchecks", no_argument, NULL, OPTIONID_adaptive_partialchecks },
                 { "modelchecker-compactreasons", no_argument, NULL, OPTIONID_modelchecker_compactreasons },                
                 
                 /* WEAK CONSTRAINTS */
@@ -498,6 +521,10 @@ Options::parse(
                     statsVerbosity = atoi( optarg );
                 }
                 break;
+
+            case OPTIONID_statsstages:
+                stageStatistics = optarg;
+                break;
                 
             case OPTIONID_multi:
                 outputPolicy = MULTI;
@@ -524,7 +551,10 @@ Options::parse(
                     if( !strcmp( optarg, "python" ) )
                         interpreter = PYTHON_INTERPRETER;
                     else
-                    #endif                    
+                    #endif
+                    if( !strcmp( optarg, "native" ) )
+                        interpreter = NATIVE_INTERPRETER;
+                    else
                         WaspErrorMessage::errorGeneric( "Unkwown interpreter." );
                 }
                 break;
@@ -626,6 +656,29 @@ Options::parse(
             case OPTIONID_multiaggregates:
                 multiAggregates = true;
                 break;
+
+            case OPTIONID_cuttingplanes:
+                cuttingPlanes = true;
+                break;
+
+            case OPTIONID_recomputecomponents:
+                recomputeComponentsOnRestart = true;
+                break;
+
+            case OPTIONID_aggregatesencoding:
+                if( optarg )
+                    aggregatesEncoding = getAggregatesEncoding( string( optarg ) );
+                else
+                    WaspErrorMessage::errorGeneric( "Inserted invalid encoding for aggregates." );
+                break;
+
+            case OPTIONID_dumpsnapshot:
+                dumpSnapshot = optarg;
+                break;
+
+            case OPTIONID_loadsnapshot:
+                loadSnapshot = optarg;
+                break;
                 
             case OPTIONID_help:
                 WaspHelp::printHelp();
@@ -729,6 +782,11 @@ Options::parse(
                 
             case OPTIONID_heuristic_partialchecks:
                 heuristicPartialChecks = true;
+                break;
+
+            case OPTIONID_adaptive_partialchecks:
+                forwardPartialChecks = true;
+                adaptivePartialChecks = true;
                 break;                         
 
             case OPTIONID_weakconstraintsalgorithm:
@@ -909,6 +967,8 @@ Options::setOptions(
     waspFacade.setOutputPolicy( outputPolicy );
     waspFacade.setRestartsPolicy( restartsPolicy, restartsThreshold );    
     waspFacade.setMinimizeUnsatCore( minimizeUnsatCore );    
+    waspFacade.setCuttingPlanes( cuttingPlanes );
+    waspFacade.setRecomputeComponentsOnRestart( recomputeComponentsOnRestart );
 }
 
 WEAK_CONSTRAINTS_ALG
@@ -944,6 +1004,17 @@ Options::getMinimizationStrategy(
     return it->second;    
 }
 
+unsigned int
+Options::getAggregatesEncoding(
+    const string& s )
+{
+    map< string, unsigned int >::iterator it = stringToAggregatesEncoding.find( s );
+    if( it == stringToAggregatesEncoding.end() )
+        WaspErrorMessage::errorGeneric( "Inserted invalid encoding for aggregates." );
+
+    return it->second;
+}
+
 unsigned int
 Options::getQueryAlgorithm(
     const string& s )
@@ -1004,6 +1075,10 @@ Options::initMap()
     
     stringToMinimization[ "progression" ] = MINIMIZATION_PROGRESSION;
     stringToMinimization[ "linearsearch" ] = MINIMIZATION_LINEARSEARCH;
+
+    stringToAggregatesEncoding[ "auto" ] = AGGREGATES_ENCODING_AUTO;
+    stringToAggregatesEncoding[ "propagator" ] = AGGREGATES_ENCODING_PROPAGATOR;
+    stringToAggregatesEncoding[ "clauses" ] = AGGREGATES_ENCODING_CLAUSES;
     
     stringToQueryAlgorithms[ "or" ] = OVERESTIMATE_REDUCTION;
     stringToQueryAlgorithms[ "ict" ] = ITERATIVE_COHERENCE_TESTING;
@@ -1045,6 +1120,9 @@ Options::checkOptions()
     
     if( modelcheckerAlgorithm == UNFOUNDED_BASED && forwardPartialChecks )
         WaspErrorMessage::errorGeneric( "Partial checks are not available for the unfounded based approach" );
+
+    if( adaptivePartialChecks && heuristicPartialChecks )
+        WaspErrorMessage::errorGeneric( "Adaptive partial checks cannot be combined with heuristic partial checks" );
 }
 
 };
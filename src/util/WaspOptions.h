@@ -45,6 +45,7 @@ namespace wasp
             static unsigned int maxCost;        
             static bool forwardPartialChecks;
             static bool heuristicPartialChecks;
+            static bool adaptivePartialChecks;
             
             static unsigned int queryAlgorithm;
             static unsigned int queryVerbosity;
@@ -60,6 +61,9 @@ namespace wasp
             static vector< string > pluginsFilenames;
             static SHIFT_STRATEGY shiftStrategy;
             static string scriptDirectory;
+
+            static string dumpSnapshot;
+            static string loadSnapshot;
             
             static bool oneDefShift;
             
@@ -126,6 +130,7 @@ namespace wasp
             static bool stats;
             
             static unsigned int statsVerbosity;
+            static string stageStatistics;
             
             static double initVariableIncrement;
             static double initVariableDecay;
@@ -134,6 +139,9 @@ namespace wasp
             static unsigned int initSign;
             
             static bool multiAggregates;
+            static bool cuttingPlanes;
+            static bool recomputeComponentsOnRestart;
+            static unsigned int aggregatesEncoding;
             static bool queryCoreCache;
             
             static unsigned int predMinimizationAlgorithm;
@@ -153,6 +161,8 @@ namespace wasp
             
             static map< string, unsigned int > stringToPredMinimization;
             
+            static map< string, unsigned int > stringToAggregatesEncoding;
+            
             static WEAK_CONSTRAINTS_ALG getAlgorithm( const string& s );
             
             static SHIFT_STRATEGY getShiftStrategy( const string& s );
@@ -165,6 +175,8 @@ namespace wasp
             
             static unsigned int getInitMinisatHeuristic( const string& s );
             
+            static unsigned int getAggregatesEncoding( const string& s );
+            
             static void initMap();
             
             static void checkOptions();
@@ -0,0 +1,21 @@
+input = """
+asp 1 0 0
+1 1 3 1 2 3 0 0
+1 0 1 4 1 2 3 1 1 -2 2 3 1
+4 1 a 1 1
+4 1 b 1 2
+4 1 c 1 3
+4 1 d 1 4
+4 4 e(1) 0
+0
+"""
+output = """
+{e(1), d}
+{e(1), a, d}
+{e(1), b}
+{e(1), c, d}
+{e(1), a, b}
+{e(1), a, c, d}
+{e(1), b, c}
+{e(1), a, b, c, d}
+"""
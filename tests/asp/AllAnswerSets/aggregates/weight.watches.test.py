@@ -0,0 +1,83 @@
+input = """
+3 8 2 3 4 5 6 7 8 9 0 0
+5 10 10 8 0 2 3 4 5 6 7 8 9 5 4 3 3 2 2 1 1
+5 11 13 8 2 2 3 4 5 6 7 8 9 1 1 3 3 2 2 1 1
+1 1 1 1 10
+1 1 1 0 11
+1 1 2 0 2 3
+1 1 2 0 6 7
+0
+2 a
+3 b
+4 c
+5 d
+6 e
+7 f
+8 g
+9 h
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{d, a, c}
+{d, b, c}
+{e, d, b, c}
+{e, d, a, c}
+{e, d, a}
+{e, a, c}
+{f, a, c}
+{f, d, a, c}
+{f, d, a}
+{f, d, b, c}
+{g, d, f, b, c}
+{g, d, f, b}
+{g, d, f, a}
+{g, d, f, a, c}
+{g, d, a, c}
+{g, d, b, c}
+{g, d, e, b, c}
+{g, d, e, b}
+{g, d, e, a}
+{g, d, e, a, c}
+{g, e, a, c}
+{g, e, b, c}
+{g, f, a, c}
+{g, f, b, c}
+{h, f, g, b, c}
+{h, f, g, a, c}
+{h, f, a, c}
+{h, f, b, c}
+{h, f, d, b, c}
+{h, f, d, b}
+{h, f, d, a}
+{h, f, d, a, c}
+{h, f, d, g, a, c}
+{h, f, d, g, a}
+{h, f, d, g, b}
+{h, f, d, g, c, b}
+{h, f, d, g, c}
+{h, d, g, b, c}
+{h, d, g, a, c}
+{h, d, g, a}
+{h, d, a, c}
+{h, d, b, c}
+{h, a, c, g}
+{h, e, g, a, c}
+{h, e, g, b, c}
+{h, e, b, c}
+{h, e, a, c}
+{h, e, d, a, c}
+{h, e, d, a}
+{h, e, d, b}
+{h, e, d, b, c}
+{h, e, d, g, b, c}
+{h, e, d, g, b}
+{h, e, d, g, c}
+{h, e, d, g, a, c}
+{h, e, d, g, a}
+"""
@@ -0,0 +1,14 @@
+input = """
+asp 1 0 0
+1 0 1 1 0 1 2
+1 0 1 2 0 1 1
+1 0 2 1 3 0 0
+4 1 a 1 1
+4 1 b 1 2
+4 1 c 1 3
+0
+"""
+output = """
+{a, b}
+{c}
+"""
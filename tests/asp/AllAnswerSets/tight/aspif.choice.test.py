@@ -0,0 +1,15 @@
+input = """
+asp 1 0 0
+1 1 2 1 2 0 0
+1 0 1 3 0 2 1 -2
+1 0 0 0 2 1 2
+4 1 a 1 1
+4 1 c 1 3
+10 b is hidden
+0
+"""
+output = """
+{}
+{}
+{a, c}
+"""
@@ -0,0 +1,28 @@
+input = """
+3 3 2 3 4 0 0
+2 5 3 0 2 2 3 4
+5 6 4 3 0 2 3 4 1 2 3
+0
+2 a
+3 b
+4 c
+5 d
+6 e
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{}
+{a}
+{b}
+{c}
+{a, b, d}
+{a, c, d, e}
+{b, c, d, e}
+{a, b, c, d, e}
+"""
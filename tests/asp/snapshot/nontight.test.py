@@ -0,0 +1,26 @@
+input = """
+3 1 4 0 0
+1 2 1 0 3
+1 3 1 0 2
+1 2 1 0 4
+1 5 1 0 6
+1 6 1 0 5
+1 5 1 1 4
+0
+2 a
+3 b
+4 e
+5 c
+6 d
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{c, d}
+{a, b, e}
+"""
@@ -0,0 +1,29 @@
+input = """
+3 4 2 3 4 5 0 0
+5 6 4 4 0 2 3 4 5 2 3 1 2
+1 1 1 1 6
+0
+2 a
+3 b
+4 c
+5 d
+6 h
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{a, b, h}
+{a, d, h}
+{b, c, h}
+{b, d, h}
+{a, b, c, h}
+{a, b, d, h}
+{a, c, d, h}
+{b, c, d, h}
+{a, b, c, d, h}
+"""
@@ -0,0 +1,21 @@
+input = """
+3 2 2 3 0 0
+1 4 2 1 3 2
+1 1 1 0 4
+0
+2 a
+3 b
+4 c
+0
+B+
+0
+B-
+1
+0
+1
+"""
+output = """
+{}
+{b}
+{a, b}
+"""
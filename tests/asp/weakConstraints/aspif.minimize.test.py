@@ -0,0 +1,15 @@
+input = """
+asp 1 0 0
+1 1 3 1 2 3 0 0
+1 0 0 0 3 -1 -2 -3
+1 0 0 0 2 2 -3
+2 1 2 1 3 3 1
+2 2 1 2 -1
+4 1 a 1 1
+4 1 b 1 2
+4 1 c 1 3
+0
+"""
+output = """
+COST 0@2 1@1
+"""